@@ -0,0 +1,47 @@
+// Entry point shared by every benchmark in OCRBench. Same flags as
+// BENCHMARK_MAIN(), but results are also written as JSON to
+// OCRBench.json unless --benchmark_out is given, so every run leaves a
+// file that can be compared with the previous commit's, e.g. with
+// Google Benchmark's tools/compare.py.
+//
+// If OCR_BENCH_COMMIT is set (to a commit id, say) it is recorded in the
+// JSON context alongside the machine description.
+
+#include <benchmark/benchmark.h>
+
+#include "Logger.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+int main(int argc, char* argv[]) {
+    std::vector<char*> args(argv, argv + argc);
+
+    bool hasOut = false;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strncmp(argv[i], "--benchmark_out=", 16) == 0) hasOut = true;
+    }
+    std::string out = "--benchmark_out=OCRBench.json";
+    std::string format = "--benchmark_out_format=json";
+    if (!hasOut) {
+        args.push_back(&out[0]);
+        args.push_back(&format[0]);
+    }
+    int count = static_cast<int>(args.size());
+
+    // The pool and engine pools log at Info on every start and stop
+    set_log_level(LogLevel::Warn);
+
+    if (const char* commit = std::getenv("OCR_BENCH_COMMIT")) {
+        benchmark::AddCustomContext("commit", commit);
+    }
+
+    benchmark::Initialize(&count, args.data());
+    if (benchmark::ReportUnrecognizedArguments(count, args.data())) return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    flush_log();
+    return 0;
+}
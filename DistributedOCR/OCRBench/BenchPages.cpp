@@ -0,0 +1,24 @@
+#include "BenchPages.h"
+#include "SyntheticImages.h"
+
+#include <map>
+#include <mutex>
+#include <random>
+#include <tuple>
+
+const std::string& bench_page(int width, int height, const std::string& format) {
+    static std::mutex mutex;
+    static std::map<std::tuple<int, int, std::string>, std::string> pages;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto key = std::make_tuple(width, height, format);
+    auto it = pages.find(key);
+    if (it == pages.end()) {
+        ImageSpec spec;
+        spec.width = width;
+        spec.height = height;
+        std::mt19937 rng(static_cast<unsigned>(width * 31 + height));
+        it = pages.emplace(key, render_page(spec, random_page_text(rng, spec), format).encoded).first;
+    }
+    return it->second;
+}
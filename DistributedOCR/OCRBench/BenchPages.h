@@ -0,0 +1,9 @@
+#pragma once
+
+#include <string>
+
+// Encoded synthetic page (see SyntheticImages) of the given size and
+// format (".png" or ".jpg"), rendered on first use and reused after that,
+// so setup cost stays out of the timed loops. The text is seeded from the
+// size, so every run measures the same pages.
+const std::string& bench_page(int width, int height, const std::string& format);
@@ -0,0 +1,66 @@
+// Image decoding as the server did it before and does it now: a full
+// colour decode followed by cvtColor, against decoding straight to
+// grayscale, by format and page size.
+
+#include <benchmark/benchmark.h>
+
+#include "BenchPages.h"
+
+#include <opencv2/opencv.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Page sizes: a receipt, A4 at 150 dpi and A4 at 300 dpi.
+static const int SIZES[][2] = { { 600, 1000 }, { 1240, 1754 }, { 2480, 3508 } };
+static const char* const FORMATS[] = { ".png", ".jpg" };
+
+// range(0): index into FORMATS. range(1): index into SIZES.
+static const std::string& page_for(const benchmark::State& state) {
+    const auto& size = SIZES[state.range(1)];
+    return bench_page(size[0], size[1], FORMATS[state.range(0)]);
+}
+
+static void set_counters(benchmark::State& state, const std::string& bytes) {
+    const auto& size = SIZES[state.range(1)];
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(bytes.size()));
+    state.counters["megapixels"] = size[0] * size[1] / 1e6;
+    state.SetLabel(std::string(FORMATS[state.range(0)] + 1) + " "
+        + std::to_string(size[0]) + "x" + std::to_string(size[1]));
+}
+
+static void BM_DecodeColorThenGray(benchmark::State& state) {
+    const std::string& bytes = page_for(state);
+    const cv::Mat encoded(1, static_cast<int>(bytes.size()), CV_8UC1,
+        const_cast<char*>(bytes.data()));
+
+    for (auto _ : state) {
+        cv::Mat color = cv::imdecode(encoded, cv::IMREAD_COLOR);
+        cv::Mat gray;
+        cv::cvtColor(color, gray, cv::COLOR_BGR2GRAY);
+        benchmark::DoNotOptimize(gray.data);
+    }
+    set_counters(state, bytes);
+}
+
+static void BM_DecodeGray(benchmark::State& state) {
+    const std::string& bytes = page_for(state);
+    const cv::Mat encoded(1, static_cast<int>(bytes.size()), CV_8UC1,
+        const_cast<char*>(bytes.data()));
+
+    for (auto _ : state) {
+        cv::Mat gray = cv::imdecode(encoded, cv::IMREAD_GRAYSCALE);
+        benchmark::DoNotOptimize(gray.data);
+    }
+    set_counters(state, bytes);
+}
+
+static void decode_args(benchmark::internal::Benchmark* b) {
+    b->ArgNames({ "format", "size" });
+    b->ArgsProduct({ { 0, 1 }, { 0, 1, 2 } });
+    b->Unit(benchmark::kMillisecond);
+}
+
+BENCHMARK(BM_DecodeColorThenGray)->Apply(decode_args);
+BENCHMARK(BM_DecodeGray)->Apply(decode_args);
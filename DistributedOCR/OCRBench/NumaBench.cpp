@@ -0,0 +1,95 @@
+// NUMA locality of the worker pool: one submitter thread per node enqueues
+// images it has just written (so their pages sit in its node's memory, as
+// a gRPC thread's parsed request does), and the stub recognizer reads every
+// byte. With node groups on, the image is read by a worker on the same
+// node unless that node runs dry; off, by whichever worker is free.
+//
+// On a single-node machine both variants are the same scheduler and should
+// measure the same.
+
+#include <benchmark/benchmark.h>
+
+#include "CpuTopology.h"
+#include "OcrWorkerPool.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+
+static const int JOBS_PER_NODE = 200;
+static const std::size_t PAYLOAD_BYTES = 1 << 20; // a compressed A4 scan
+
+static OcrResult summing_recognizer(const std::string& imageBytes, const CancellationToken*,
+    const OcrSettings&) {
+    const auto sum = std::accumulate(imageBytes.begin(), imageBytes.end(), std::uint64_t(0),
+        [](std::uint64_t total, char c) { return total + static_cast<unsigned char>(c); });
+    benchmark::DoNotOptimize(sum);
+    return OcrResult{ "text", 0, {} };
+}
+
+// range(0): 1 to group workers by NUMA node, 0 for one flat group.
+static void BM_PoolNumaLocality(benchmark::State& state) {
+    const CpuTopology& topology = system_topology();
+    const std::vector<int> nodes = topology.nodeIds();
+    const std::size_t workers = topology.coreCount();
+
+    // Workers are kept on their node either way; only routing differs
+    const CoreAssignment cores = assign_cores(topology, 0, workers);
+    std::vector<int> workerNodes;
+    for (const auto& cpus : cores.workerCpus) workerNodes.push_back(topology.nodeOf(cpus.front()));
+    auto pinToNode = [&topology, workerNodes](std::size_t i) {
+        pin_current_thread(topology.nodeCpus(workerNodes[i]));
+    };
+
+    OcrWorkerPool pool(workers, JOBS_PER_NODE * nodes.size(), PoolScheduling::WorkStealing,
+        pinToNode, state.range(0) ? workerNodes : std::vector<int>());
+    pool.setRecognizer(summing_recognizer);
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    int remaining = 0;
+    auto onDone = [&](std::exception_ptr, OcrResult) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--remaining == 0) cv.notify_one();
+    };
+
+    std::uint64_t sequence = 0;
+    for (auto _ : state) {
+        remaining = JOBS_PER_NODE * static_cast<int>(nodes.size());
+
+        std::vector<std::thread> submitters;
+        for (std::size_t n = 0; n < nodes.size(); ++n) {
+            const std::uint64_t first = sequence + n * JOBS_PER_NODE;
+            submitters.emplace_back([&, n, first] {
+                pin_current_thread(topology.nodeCpus(nodes[n]));
+                for (int j = 0; j < JOBS_PER_NODE; ++j) {
+                    // Distinct bytes per job, or the pool would coalesce them
+                    std::string bytes(PAYLOAD_BYTES, '\x5a');
+                    const std::uint64_t id = first + j;
+                    std::memcpy(&bytes[0], &id, sizeof(id));
+                    pool.enqueue(j, std::move(bytes), OcrCallback(onDone));
+                }
+            });
+        }
+        for (auto& t : submitters) t.join();
+        sequence += JOBS_PER_NODE * nodes.size();
+
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [&] { return remaining == 0; });
+    }
+
+    state.SetItemsProcessed(state.iterations() * JOBS_PER_NODE * nodes.size());
+    state.SetBytesProcessed(state.iterations() * JOBS_PER_NODE * nodes.size() * PAYLOAD_BYTES);
+    state.counters["numa_nodes"] = static_cast<double>(nodes.size());
+}
+
+BENCHMARK(BM_PoolNumaLocality)
+    ->ArgName("numa")
+    ->Arg(0)->Arg(1)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
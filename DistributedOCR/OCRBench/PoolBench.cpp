@@ -0,0 +1,91 @@
+// OcrWorkerPool round trip: enqueue, admission, single-flight bookkeeping,
+// scheduling and completion, with recognition replaced by a stub of about
+// JOB_SPIN_NS so the pool's own overhead is what gets measured.
+
+#include <benchmark/benchmark.h>
+
+#include "OcrWorkerPool.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <vector>
+
+static const int JOBS_PER_ITERATION = 2000;
+static const auto JOB_SPIN_NS = std::chrono::nanoseconds(1000);
+
+static OcrResult stub_recognizer(const std::string&, const CancellationToken*,
+    const OcrSettings&) {
+    const auto until = std::chrono::steady_clock::now() + JOB_SPIN_NS;
+    while (std::chrono::steady_clock::now() < until) {
+    }
+    return OcrResult{ "text", 0, {} };
+}
+
+// Distinct bytes per job, or the pool would coalesce them all into one.
+static std::string job_bytes(std::uint64_t n) {
+    std::string bytes(64, 'x');
+    std::memcpy(&bytes[0], &n, sizeof(n));
+    return bytes;
+}
+
+// range(0): workers. range(1): 1 for work stealing, 0 for the shared
+// queue. range(2): 1 to enqueue the iteration as one batch, 0 job by job.
+static void BM_PoolRoundTrip(benchmark::State& state) {
+    const std::size_t workers = static_cast<std::size_t>(state.range(0));
+    const auto scheduling = state.range(1) ? PoolScheduling::WorkStealing
+        : PoolScheduling::EarliestDeadlineFirst;
+    const bool batched = state.range(2) != 0;
+
+    OcrWorkerPool pool(workers, JOBS_PER_ITERATION, scheduling);
+    pool.setRecognizer(stub_recognizer);
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    int remaining = 0;
+    auto onDone = [&](std::exception_ptr, OcrResult) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--remaining == 0) cv.notify_one();
+    };
+
+    std::uint64_t sequence = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        std::vector<std::string> images;
+        images.reserve(JOBS_PER_ITERATION);
+        for (int i = 0; i < JOBS_PER_ITERATION; ++i) images.push_back(job_bytes(sequence++));
+        remaining = JOBS_PER_ITERATION;
+        state.ResumeTiming();
+
+        if (batched) {
+            std::vector<OcrTask> tasks;
+            tasks.reserve(JOBS_PER_ITERATION);
+            for (int i = 0; i < JOBS_PER_ITERATION; ++i) {
+                tasks.push_back(OcrTask{ i, std::move(images[i]), OcrSettings() });
+            }
+            pool.enqueueBatch(std::move(tasks),
+                [&](std::size_t, std::exception_ptr error, OcrResult result) {
+                    onDone(error, std::move(result));
+                });
+        }
+        else {
+            for (int i = 0; i < JOBS_PER_ITERATION; ++i) {
+                pool.enqueue(i, std::move(images[i]), OcrCallback(onDone));
+            }
+        }
+
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [&] { return remaining == 0; });
+    }
+
+    state.SetItemsProcessed(state.iterations() * JOBS_PER_ITERATION);
+}
+
+BENCHMARK(BM_PoolRoundTrip)
+    ->ArgNames({ "workers", "stealing", "batched" })
+    ->ArgsProduct({ { 1, 4, 16 }, { 0, 1 }, { 0, 1 } })
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
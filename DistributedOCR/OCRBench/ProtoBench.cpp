@@ -0,0 +1,99 @@
+// Protobuf cost per call: serializing and parsing BatchRequest with
+// realistic image payloads, and BatchResponse with page-sized texts and
+// stage timings.
+
+#include <benchmark/benchmark.h>
+
+#include "ocr_service.pb.h"
+
+#include <cstdint>
+#include <string>
+
+// Result text of a dense A4 page.
+static const std::size_t RESULT_TEXT_BYTES = 3000;
+
+// range(0): images per request. range(1): bytes per image.
+static ocr::BatchRequest make_request(const benchmark::State& state) {
+    ocr::BatchRequest request;
+    for (int i = 0; i < state.range(0); ++i) {
+        ocr::ImageTask* task = request.add_tasks();
+        task->set_id(i + 1);
+        task->set_image_data(std::string(static_cast<std::size_t>(state.range(1)), '\x5a'));
+        task->set_language("eng");
+    }
+    request.set_client_id("bench");
+    return request;
+}
+
+static ocr::BatchResponse make_response(const benchmark::State& state) {
+    ocr::BatchResponse response;
+    for (int i = 0; i < state.range(0); ++i) {
+        ocr::BatchResult* result = response.add_results();
+        result->set_id(i + 1);
+        result->set_text(std::string(RESULT_TEXT_BYTES, 'e'));
+        result->set_processing_time_ms(850);
+        ocr::StageTimings* timings = result->mutable_timings();
+        timings->set_queue_wait_us(1200);
+        timings->set_decode_us(25000);
+        timings->set_preprocess_us(18000);
+        timings->set_recognition_us(800000);
+        timings->set_total_us(845000);
+    }
+    return response;
+}
+
+template <class Message>
+static void serialize(benchmark::State& state, const Message& message) {
+    std::string wire;
+    for (auto _ : state) {
+        wire.clear();
+        message.SerializeToString(&wire);
+        benchmark::DoNotOptimize(wire.data());
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(wire.size()));
+}
+
+template <class Message>
+static void parse(benchmark::State& state, const Message& message) {
+    const std::string wire = message.SerializeAsString();
+    Message parsed;
+    for (auto _ : state) {
+        parsed.ParseFromString(wire);
+        benchmark::DoNotOptimize(&parsed);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(wire.size()));
+}
+
+static void BM_SerializeBatchRequest(benchmark::State& state) {
+    serialize(state, make_request(state));
+}
+
+static void BM_ParseBatchRequest(benchmark::State& state) {
+    parse(state, make_request(state));
+}
+
+static void BM_SerializeBatchResponse(benchmark::State& state) {
+    serialize(state, make_response(state));
+}
+
+static void BM_ParseBatchResponse(benchmark::State& state) {
+    parse(state, make_response(state));
+}
+
+// Batches of 1 to 64 images of 50 KB (a compressed scan) to 4 MB.
+static void request_args(benchmark::internal::Benchmark* b) {
+    b->ArgNames({ "images", "image_bytes" });
+    b->ArgsProduct({ { 1, 16, 64 }, { 50 << 10, 500 << 10, 4 << 20 } });
+    b->Unit(benchmark::kMicrosecond);
+}
+
+static void response_args(benchmark::internal::Benchmark* b) {
+    b->ArgName("results");
+    b->Arg(1)->Arg(16)->Arg(64);
+    b->Unit(benchmark::kMicrosecond);
+}
+
+BENCHMARK(BM_SerializeBatchRequest)->Apply(request_args);
+BENCHMARK(BM_ParseBatchRequest)->Apply(request_args);
+BENCHMARK(BM_SerializeBatchResponse)->Apply(response_args);
+BENCHMARK(BM_ParseBatchResponse)->Apply(response_args);
@@ -0,0 +1,56 @@
+// run_ocr_on_bytes() end to end, per image class: decode, preprocessing
+// as configured by default and Tesseract recognition, on one engine.
+//
+// Needs the "eng" model: set TESSDATA_PREFIX to the tessdata directory
+// (the server's built-in path is used otherwise). Skipped with an error if
+// the model cannot be loaded.
+
+#include <benchmark/benchmark.h>
+
+#include "BenchPages.h"
+#include "OcrProcessor.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <string>
+
+// Image classes: a receipt, A4 at 150 dpi, A4 at 300 dpi.
+static const int SIZES[][2] = { { 600, 1000 }, { 1240, 1754 }, { 2480, 3508 } };
+
+static bool engines_ready(benchmark::State& state) {
+    static std::string error = [] {
+        try {
+            const char* dir = std::getenv("TESSDATA_PREFIX");
+            init_tess_engines(dir ? dir : "", 1, 1, { "eng" });
+            return std::string();
+        }
+        catch (const std::exception& ex) {
+            return std::string(ex.what());
+        }
+    }();
+    if (!error.empty()) state.SkipWithError(error.c_str());
+    return error.empty();
+}
+
+// range(0): index into SIZES.
+static void BM_RunOcrOnBytes(benchmark::State& state) {
+    if (!engines_ready(state)) return;
+    const auto& size = SIZES[state.range(0)];
+    const std::string& bytes = bench_page(size[0], size[1], ".png");
+
+    for (auto _ : state) {
+        OcrResult result = run_ocr_on_bytes(bytes);
+        benchmark::DoNotOptimize(result.text.data());
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(bytes.size()));
+    state.SetLabel(std::to_string(size[0]) + "x" + std::to_string(size[1]));
+}
+
+BENCHMARK(BM_RunOcrOnBytes)
+    ->ArgName("size")
+    ->DenseRange(0, 2)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
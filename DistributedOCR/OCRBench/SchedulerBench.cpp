@@ -0,0 +1,158 @@
+// Scheduler microbenchmark: how many small tasks per second the worker
+// pool's single shared queue can hand out, compared with the work-stealing
+// scheduler, as the number of workers grows.
+//
+// Each iteration submits TASKS_PER_ITERATION tasks of about TASK_SPIN_NS of
+// work and waits for all of them, so the numbers are dominated by
+// scheduling overhead rather than by the tasks themselves.
+
+#include <benchmark/benchmark.h>
+
+#include "WorkStealingScheduler.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+static const int TASKS_PER_ITERATION = 20000;
+static const auto TASK_SPIN_NS = std::chrono::nanoseconds(500);
+
+// The OcrWorkerPool design before work stealing: one mutex, one condition
+// variable, notify_one per submitted task.
+class SingleQueueScheduler {
+public:
+    using Task = std::function<void()>;
+
+    explicit SingleQueueScheduler(std::size_t numThreads) {
+        for (std::size_t i = 0; i < numThreads; ++i) {
+            threads_.emplace_back(&SingleQueueScheduler::workerLoop, this);
+        }
+    }
+
+    ~SingleQueueScheduler() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        cv_.notify_all();
+        for (auto& t : threads_) t.join();
+    }
+
+    void submit(Task task) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            tasks_.push_back(std::move(task));
+        }
+        cv_.notify_one();
+    }
+
+    void submitBatch(std::vector<Task> tasks) {
+        for (auto& task : tasks) submit(std::move(task));
+    }
+
+private:
+    void workerLoop() {
+        while (true) {
+            Task task;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cv_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+                if (stopping_ && tasks_.empty()) return;
+                task = std::move(tasks_.front());
+                tasks_.pop_front();
+            }
+            task();
+        }
+    }
+
+    std::vector<std::thread> threads_;
+    std::deque<Task> tasks_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stopping_ = false;
+};
+
+// Counts finished tasks and wakes the benchmark thread after the last one.
+class Latch {
+public:
+    void reset(int count) { remaining_ = count; }
+
+    void countDown() {
+        if (remaining_.fetch_sub(1) == 1) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            cv_.notify_one();
+        }
+    }
+
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this] { return remaining_.load() == 0; });
+    }
+
+private:
+    std::atomic<int> remaining_{ 0 };
+    std::mutex mutex_;
+    std::condition_variable cv_;
+};
+
+static void spin_for(std::chrono::nanoseconds duration) {
+    const auto until = std::chrono::steady_clock::now() + duration;
+    while (std::chrono::steady_clock::now() < until) {
+    }
+}
+
+// range(0): worker threads. range(1): 1 to submit the whole iteration as
+// one batch, 0 to submit task by task.
+template <class Scheduler>
+static void BM_Scheduler(benchmark::State& state) {
+    Scheduler scheduler(static_cast<std::size_t>(state.range(0)));
+    const bool batched = state.range(1) != 0;
+    Latch latch;
+
+    for (auto _ : state) {
+        latch.reset(TASKS_PER_ITERATION);
+
+        if (batched) {
+            std::vector<std::function<void()>> tasks;
+            tasks.reserve(TASKS_PER_ITERATION);
+            for (int i = 0; i < TASKS_PER_ITERATION; ++i) {
+                tasks.emplace_back([&latch] {
+                    spin_for(TASK_SPIN_NS);
+                    latch.countDown();
+                });
+            }
+            scheduler.submitBatch(std::move(tasks));
+        }
+        else {
+            for (int i = 0; i < TASKS_PER_ITERATION; ++i) {
+                scheduler.submit([&latch] {
+                    spin_for(TASK_SPIN_NS);
+                    latch.countDown();
+                });
+            }
+        }
+
+        latch.wait();
+    }
+
+    state.SetItemsProcessed(state.iterations() * TASKS_PER_ITERATION);
+}
+
+static void scheduler_args(benchmark::internal::Benchmark* b) {
+    b->ArgNames({ "workers", "batched" });
+    for (int workers : { 4, 16, 64 }) {
+        for (int batched : { 0, 1 }) {
+            b->Args({ workers, batched });
+        }
+    }
+    b->UseRealTime()->Unit(benchmark::kMillisecond);
+}
+
+BENCHMARK_TEMPLATE(BM_Scheduler, SingleQueueScheduler)->Apply(scheduler_args);
+BENCHMARK_TEMPLATE(BM_Scheduler, WorkStealingScheduler)->Apply(scheduler_args);
@@ -1,7 +1,11 @@
 #include "GrpcOcrClient.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <exception>
 #include <fstream>
 #include <stdexcept>
+#include <thread>
 
 using grpc::Channel;
 using grpc::ClientContext;
@@ -9,25 +13,25 @@ using grpc::Status;
 
 using ocr::BatchRequest;
 using ocr::BatchResponse;
+using ocr::BatchResult;
+using ocr::ImageChunk;
 using ocr::ImageTask;
 
 static std::string read_file_bytes(const std::string& path) {
-    std::ifstream f(path, std::ios::binary);
+    std::ifstream f(path, std::ios::binary | std::ios::ate);
     if (!f) {
         throw std::runtime_error("Could not open file: " + path);
     }
-    std::vector<char> buf((std::istreambuf_iterator<char>(f)),
-        std::istreambuf_iterator<char>());
-    return std::string(buf.begin(), buf.end());
-}
-
-GrpcOcrClient::GrpcOcrClient(const std::string& serverAddress) {
-    auto channel = grpc::CreateChannel(serverAddress,
-        grpc::InsecureChannelCredentials());
-    stub_ = ocr::OCRService::NewStub(channel);
+    // Read straight into the string that ends up in the message
+    std::string bytes(static_cast<std::size_t>(f.tellg()), '\0');
+    f.seekg(0);
+    if (!bytes.empty() && !f.read(&bytes[0], static_cast<std::streamsize>(bytes.size()))) {
+        throw std::runtime_error("Could not read file: " + path);
+    }
+    return bytes;
 }
 
-BatchResponse GrpcOcrClient::sendBatch(const std::vector<std::string>& imagePaths) {
+static BatchRequest build_request(const std::vector<std::string>& imagePaths) {
     BatchRequest request;
 
     int id = 1;
@@ -36,39 +40,212 @@ BatchResponse GrpcOcrClient::sendBatch(const std::vector<std::string>& imagePath
 
         ImageTask* task = request.add_tasks();
         task->set_id(id++);
-        task->set_image_data(bytes);
+        task->set_image_data(std::move(bytes));
     }
+    return request;
+}
+
+static void throw_rpc_error(const Status& status, const ClientContext& ctx) {
+    std::string friendly;
+
+    switch (status.error_code()) {
+    case grpc::StatusCode::UNAVAILABLE:
+        // Server died / network lost while we were talking to it
+        friendly = "Connection lost. Please try again later.";
+        break;
+
+    case grpc::StatusCode::RESOURCE_EXHAUSTED: {
+        // Server refused the whole batch because its queue is full
+        friendly = "The OCR server is busy. Please try again later.";
+        const auto& trailers = ctx.GetServerTrailingMetadata();
+        auto it = trailers.find("retry-after-ms");
+        if (it != trailers.end()) {
+            friendly = "The OCR server is busy. Please try again in about "
+                + std::string(it->second.data(), it->second.size()) + " ms.";
+        }
+        break;
+    }
+
+    case grpc::StatusCode::DEADLINE_EXCEEDED:
+        // Server took too long to respond
+        friendly = "The OCR server took too long to respond (timeout).";
+        break;
+
+    default:
+        // Fallback: show the raw gRPC message
+        friendly = status.error_message();
+        break;
+    }
+
+    // This is what MainWindow will display
+    throw RpcError(status.error_code(),
+        "RPC failed (code=" + std::to_string(status.error_code()) +
+        "): " + friendly
+    );
+}
 
+GrpcOcrClient::GrpcOcrClient(const std::string& serverAddress) {
+    auto channel = grpc::CreateChannel(serverAddress,
+        grpc::InsecureChannelCredentials());
+    stub_ = ocr::OCRService::NewStub(channel);
+}
+
+void GrpcOcrClient::applyDeadline(ClientContext& ctx) const {
+    if (deadline_.count() > 0) {
+        ctx.set_deadline(std::chrono::system_clock::now() + deadline_);
+    }
+}
+
+BatchResponse GrpcOcrClient::sendBatch(const std::vector<std::string>& imagePaths) {
+    return sendBatch(build_request(imagePaths));
+}
+
+BatchResponse GrpcOcrClient::sendBatch(const BatchRequest& request) {
     BatchResponse reply;
     ClientContext ctx;
+    applyDeadline(ctx);
     Status status = stub_->ProcessBatch(&ctx, request, &reply);
 
     if (!status.ok()) {
-        std::string friendly;
-
-        switch (status.error_code()) {
-        case grpc::StatusCode::UNAVAILABLE:
-            // Server died / network lost while we were talking to it
-            friendly = "Connection lost. Please try again later.";
-            break;
-
-        case grpc::StatusCode::DEADLINE_EXCEEDED:
-            // Server took too long to respond
-            friendly = "The OCR server took too long to respond (timeout).";
-            break;
-
-        default:
-            // Fallback: show the raw gRPC message
-            friendly = status.error_message();
-            break;
+        throw_rpc_error(status, ctx);
+    }
+
+    return reply;
+}
+
+void GrpcOcrClient::sendBatchStream(const std::vector<std::string>& imagePaths,
+    const std::function<void(const BatchResult&)>& onResult) {
+    BatchRequest request = build_request(imagePaths);
+
+    ClientContext ctx;
+    applyDeadline(ctx);
+    auto reader = stub_->ProcessBatchStream(&ctx, request);
+
+    BatchResult result;
+    while (reader->Read(&result)) {
+        onResult(result);
+    }
+
+    Status status = reader->Finish();
+    if (!status.ok()) {
+        throw_rpc_error(status, ctx);
+    }
+}
+
+void GrpcOcrClient::processStream(const std::vector<std::string>& imagePaths,
+    const std::function<void(const BatchResult&)>& onResult) {
+    ClientContext ctx;
+    applyDeadline(ctx);
+    auto stream = stub_->Process(&ctx);
+
+    // Only one image is held in memory at a time on the upload side
+    std::exception_ptr uploadError;
+    std::thread uploader([&] {
+        try {
+            int id = 1;
+            for (const auto& path : imagePaths) {
+                ImageTask task;
+                task.set_id(id++);
+                task.set_image_data(read_file_bytes(path));
+
+                if (!stream->Write(task)) {
+                    break; // stream broken; Finish() reports why
+                }
+            }
+        }
+        catch (...) {
+            uploadError = std::current_exception();
+            ctx.TryCancel();
         }
+        stream->WritesDone();
+    });
 
-        // This is what MainWindow will display
-        throw std::runtime_error(
-            "RPC failed (code=" + std::to_string(status.error_code()) +
-            "): " + friendly
-        );
+    BatchResult result;
+    while (stream->Read(&result)) {
+        onResult(result);
     }
+    uploader.join();
 
-    return reply;
+    if (uploadError) {
+        std::rethrow_exception(uploadError);
+    }
+
+    Status status = stream->Finish();
+    if (!status.ok()) {
+        throw_rpc_error(status, ctx);
+    }
+}
+
+void GrpcOcrClient::processChunked(const std::vector<std::string>& imagePaths,
+    const std::function<void(const BatchResult&)>& onResult,
+    std::size_t chunkBytes) {
+    if (chunkBytes == 0) chunkBytes = 1024 * 1024;
+
+    ClientContext ctx;
+    applyDeadline(ctx);
+    auto stream = stub_->ProcessChunked(&ctx);
+
+    // Only one chunk is held in memory at a time on the upload side
+    std::exception_ptr uploadError;
+    std::thread uploader([&] {
+        try {
+            int id = 1;
+            bool broken = false;
+            for (const auto& path : imagePaths) {
+                std::ifstream f(path, std::ios::binary | std::ios::ate);
+                if (!f) {
+                    throw std::runtime_error("Could not open file: " + path);
+                }
+                const std::int64_t total = static_cast<std::int64_t>(f.tellg());
+                f.seekg(0);
+
+                std::int64_t offset = 0;
+                ImageChunk chunk;
+                chunk.set_id(id);
+                chunk.set_total_size(total);
+                do {
+                    const std::size_t n = static_cast<std::size_t>(
+                        std::min<std::int64_t>(chunkBytes, total - offset));
+
+                    std::string* data = chunk.mutable_data();
+                    data->resize(n);
+                    if (n > 0 && !f.read(&(*data)[0], static_cast<std::streamsize>(n))) {
+                        throw std::runtime_error("Could not read file: " + path);
+                    }
+
+                    chunk.set_offset(offset);
+                    offset += static_cast<std::int64_t>(n);
+                    chunk.set_last(offset >= total);
+
+                    if (!stream->Write(chunk)) {
+                        broken = true; // stream broken; Finish() reports why
+                        break;
+                    }
+                } while (offset < total);
+
+                if (broken) break;
+                ++id;
+            }
+        }
+        catch (...) {
+            uploadError = std::current_exception();
+            ctx.TryCancel();
+        }
+        stream->WritesDone();
+    });
+
+    BatchResult result;
+    while (stream->Read(&result)) {
+        onResult(result);
+    }
+    uploader.join();
+
+    if (uploadError) {
+        std::rethrow_exception(uploadError);
+    }
+
+    Status status = stream->Finish();
+    if (!status.ok()) {
+        throw_rpc_error(status, ctx);
+    }
 }
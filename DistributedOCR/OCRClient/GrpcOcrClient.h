@@ -3,17 +3,62 @@
 #include <grpcpp/grpcpp.h>
 #include "ocr_service.grpc.pb.h"
 
+#include <chrono>
+#include <functional>
 #include <memory>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
+// A call the server failed or refused. what() is a message fit for the
+// user; code() tells a busy server (RESOURCE_EXHAUSTED) from a timeout
+// (DEADLINE_EXCEEDED) and the rest.
+class RpcError : public std::runtime_error {
+public:
+    RpcError(grpc::StatusCode code, const std::string& what)
+        : std::runtime_error(what), code_(code) {
+    }
+
+    grpc::StatusCode code() const { return code_; }
+
+private:
+    grpc::StatusCode code_;
+};
+
 class GrpcOcrClient {
 public:
     explicit GrpcOcrClient(const std::string& serverAddress);
 
+    // gRPC deadline applied to every call, measured from when the call
+    // starts. The server schedules and admits work against it. 0 = none.
+    void setDeadline(std::chrono::milliseconds deadline) { deadline_ = deadline; }
+
     // imagePaths = list of image file paths on the client machine
     ocr::BatchResponse sendBatch(const std::vector<std::string>& imagePaths);
 
+    // Same, for a request built by the caller (images already in memory).
+    ocr::BatchResponse sendBatch(const ocr::BatchRequest& request);
+
+    // Same batch over ProcessBatchStream: onResult is called (on the calling
+    // thread) for every result as soon as the server finishes it.
+    void sendBatchStream(const std::vector<std::string>& imagePaths,
+        const std::function<void(const ocr::BatchResult&)>& onResult);
+
+    // Pipelined upload over the bidi Process call: files are read and sent
+    // one at a time on a helper thread while results stream back here.
+    void processStream(const std::vector<std::string>& imagePaths,
+        const std::function<void(const ocr::BatchResult&)>& onResult);
+
+    // Same as processStream, but over ProcessChunked: files are streamed
+    // from disk in chunkBytes pieces, so neither side needs a whole image in
+    // one message and the 4 MB message limit no longer applies.
+    void processChunked(const std::vector<std::string>& imagePaths,
+        const std::function<void(const ocr::BatchResult&)>& onResult,
+        std::size_t chunkBytes = 1024 * 1024);
+
 private:
+    void applyDeadline(grpc::ClientContext& ctx) const;
+
     std::unique_ptr<ocr::OCRService::Stub> stub_;
+    std::chrono::milliseconds deadline_{ 0 };
 };
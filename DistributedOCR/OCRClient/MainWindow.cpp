@@ -1,5 +1,6 @@
 ﻿#include "MainWindow.h"
 #include "GrpcOcrClient.h"
+#include <chrono>
 #include <thread>
 
 #include <QtCore/QCoreApplication>  
@@ -14,6 +15,7 @@
 #include <QtWidgets/QMessageBox>
 #include <QtWidgets/QWidget>
 #include <QtWidgets/QProgressBar>
+#include <QtWidgets/QSpinBox>
 #include <QtWidgets/QListView>
 #include <QtGui/QPixmap>
 #include <QtGui/QIcon>
@@ -45,12 +47,22 @@ MainWindow::MainWindow(QWidget* parent)
     serverEdit_->setText("localhost:50051");
     serverEdit_->setPlaceholderText("host:port");
 
+    // Deadline sent with the request; the server schedules against it
+    auto* deadlineLabel = new QLabel("Deadline:", this);
+    deadlineSpin_ = new QSpinBox(this);
+    deadlineSpin_->setRange(0, 3600);
+    deadlineSpin_->setValue(120);
+    deadlineSpin_->setSuffix(" s");
+    deadlineSpin_->setSpecialValueText("none");   // shown for 0
+
     addButton_ = new QPushButton("Upload Images", this);
     runButton_ = new QPushButton("Run OCR", this);
     clearButton_ = new QPushButton("Clear", this);     
 
     topRow->addWidget(serverLabel);
     topRow->addWidget(serverEdit_, /*stretch*/ 1);
+    topRow->addWidget(deadlineLabel);
+    topRow->addWidget(deadlineSpin_);
     topRow->addSpacing(16);
     topRow->addWidget(addButton_);
     topRow->addWidget(runButton_);
@@ -163,52 +175,65 @@ void MainWindow::onRunOcr() {
     resultView_->clear();
     resultView_->append("Connecting to server " + serverAddr + "…");
 
-    // Indeterminate progress bar while RPC is in flight
+    // One step per image; results arrive one at a time
     progressBar_->setMinimum(0);
-    progressBar_->setMaximum(0);   // 0..0 = busy animation
+    progressBar_->setMaximum(static_cast<int>(paths.size()));
+    progressBar_->setValue(0);
 
 
     const std::string serverStr = serverAddr.toStdString();
+    const std::chrono::seconds deadline(deadlineSpin_->value());
 
     // Run the gRPC call on a background thread
-    std::thread([this, serverStr, paths = std::move(paths)]() mutable {
+    std::thread([this, serverStr, deadline, paths = std::move(paths)]() mutable {
         try {
             GrpcOcrClient client(serverStr);
-            ocr::BatchResponse reply = client.sendBatch(paths);
-
-            // Success: update UI on the Qt (GUI) thread
-            QMetaObject::invokeMethod(this,
-                [this, reply]() mutable {
-                    const int n = reply.results_size();
-
-                    // Now set a normal progress range
-                    progressBar_->setMinimum(0);
-                    progressBar_->setMaximum(n);
-                    progressBar_->setValue(0);
-
-                    resultView_->append(
-                        QString("RPC succeeded. Got %1 results.\n").arg(n));
-
-                    for (int i = 0; i < n; ++i) {
-                        const ocr::BatchResult& r = reply.results(i);
+            client.setDeadline(deadline);
 
+            // Images are streamed up in chunks while results come back;
+            // each result is shown as soon as the server sends it
+            client.processChunked(paths, [this](const ocr::BatchResult& r) {
+                QMetaObject::invokeMethod(this,
+                    [this, r]() {
                         resultView_->append(
                             QString("Result for id=%1:").arg(r.id()));
                         resultView_->append(
                             "text:\n" + QString::fromStdString(r.text()));
                         resultView_->append(
-                            QString("processing_time_ms: %1\n")
+                            QString("processing_time_ms: %1")
                             .arg(r.processing_time_ms()));
+                        const auto& t = r.timings();
+                        resultView_->append(
+                            QString("stages_ms: queue=%1 decode=%2 preprocess=%3 "
+                                "layout=%4 engine_wait=%5 recognition=%6 total=%7\n")
+                            .arg(t.queue_wait_us() / 1000.0, 0, 'f', 1)
+                            .arg(t.decode_us() / 1000.0, 0, 'f', 1)
+                            .arg(t.preprocess_us() / 1000.0, 0, 'f', 1)
+                            .arg(t.layout_us() / 1000.0, 0, 'f', 1)
+                            .arg(t.engine_wait_us() / 1000.0, 0, 'f', 1)
+                            .arg(t.recognition_us() / 1000.0, 0, 'f', 1)
+                            .arg(t.total_us() / 1000.0, 0, 'f', 1));
                         resultView_->append(
                             "----------------------------------------\n");
 
-                        if (i < imageList_->count()) {
-                            auto* item = imageList_->item(i);
+                        // ids are 1-based positions in the image list
+                        const int row = r.id() - 1;
+                        if (row >= 0 && row < imageList_->count()) {
+                            auto* item = imageList_->item(row);
                             item->setText(QString::fromStdString(r.text()));
                         }
 
-                        progressBar_->setValue(i + 1);
-                    }
+                        progressBar_->setValue(progressBar_->value() + 1);
+                    },
+                    Qt::QueuedConnection);
+                });
+
+            // Success: update UI on the Qt (GUI) thread
+            QMetaObject::invokeMethod(this,
+                [this]() {
+                    resultView_->append(
+                        QString("RPC succeeded. Got %1 results.\n")
+                        .arg(progressBar_->value()));
 
                     addButton_->setEnabled(true);
                     runButton_->setEnabled(true);
@@ -9,6 +9,7 @@ class QPushButton;
 class QListWidget;
 class QTextEdit;
 class QProgressBar;
+class QSpinBox;
 
 
 class MainWindow : public QMainWindow {
@@ -22,6 +23,7 @@ private:
 
     QStringList   imagePaths_;
     QLineEdit* serverEdit_;
+    QSpinBox* deadlineSpin_;
     QPushButton* addButton_;
     QPushButton* runButton_;
     QPushButton* clearButton_;   
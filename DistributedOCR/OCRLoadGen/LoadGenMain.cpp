@@ -0,0 +1,409 @@
+// Headless load generator for the OCR server. Sends ProcessBatch calls of
+// synthetic pages with known text and reports throughput, latency
+// percentiles and recognition accuracy.
+//
+//   OCRLoadGen --mode closed --concurrency 8 --batch 4 --duration 60
+//   OCRLoadGen --mode open --rate 20 --mix 1240x1754:3,2480x3508 --check
+//
+// Closed loop: --concurrency callers, each sending its next batch as soon
+// as the last one returns. Open loop: batches arrive at --rate per second
+// (Poisson) whether or not earlier ones have finished, sent by up to
+// --concurrency callers; latency counts from the scheduled arrival, so a
+// server falling behind shows up as queueing instead of being hidden by
+// the callers slowing down.
+
+#include "CommandLine.h"
+#include "GrpcOcrClient.h"
+#include "LatencyHistogram.h"
+#include "SyntheticImages.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+struct LoadGenOptions {
+    std::string server = "localhost:50051";
+    bool openLoop = false;
+    std::size_t concurrency = 4;
+    double rate = 10.0;           // open loop: batches per second
+    std::size_t batch = 1;        // images per call
+    double durationS = 30.0;      // measured, after the warm-up
+    double warmupS = 5.0;
+    std::string mix = "1240x1754"; // A4 at 150 dpi
+    std::string format = ".png";
+    std::size_t corpus = 32;      // distinct pages rendered up front
+    long long deadlineMs = 0;     // per call; 0: none
+    bool check = false;           // score recognized text against the truth
+    bool uniqueImages = true;     // defeat the server's result cache
+    unsigned seed = 1;
+};
+
+// Outcomes over the measured window.
+struct RunStats {
+    LatencyHistogram callLatency;   // per call, microseconds
+    LatencyHistogram serverLatency; // per image, the server's total_us
+
+    std::atomic<std::uint64_t> calls{ 0 };
+    std::atomic<std::uint64_t> images{ 0 };
+    std::atomic<std::uint64_t> bytes{ 0 };
+    std::atomic<std::uint64_t> rejected{ 0 };  // whole call refused as overloaded
+    std::atomic<std::uint64_t> timeouts{ 0 };  // whole call past its deadline
+    std::atomic<std::uint64_t> failed{ 0 };    // any other call failure
+    std::atomic<std::uint64_t> imageErrors{ 0 }; // [ERROR]/[TIMEOUT]/[REJECTED] results
+    // When the last measured call returned, from the start of the window;
+    // calls sent near its end finish after it, so rates are taken over this
+    std::atomic<std::int64_t> lastReturnUs{ 0 };
+
+    std::mutex accuracyMutex;
+    double accuracySum = 0.0;
+    std::uint64_t accuracyCount = 0;
+};
+
+class LoadGenerator {
+public:
+    LoadGenerator(const LoadGenOptions& options, std::vector<SyntheticImage> corpus)
+        : options_(options), corpus_(std::move(corpus)), client_(options.server) {
+        client_.setDeadline(std::chrono::milliseconds(options.deadlineMs));
+
+        std::vector<double> weights;
+        for (const auto& image : corpus_) weights.push_back(image.spec.weight);
+        pick_ = std::discrete_distribution<std::size_t>(weights.begin(), weights.end());
+    }
+
+    void run() {
+        const auto start = Clock::now();
+        measureFrom_ = start + toDuration(options_.warmupS);
+        end_ = measureFrom_ + toDuration(options_.durationS);
+
+        if (options_.openLoop) runOpen();
+        else runClosed();
+    }
+
+    void report(std::ostream& out) const;
+
+private:
+    static Clock::duration toDuration(double seconds) {
+        return std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(seconds));
+    }
+
+    void runClosed() {
+        std::vector<std::thread> callers;
+        for (std::size_t i = 0; i < options_.concurrency; ++i) {
+            callers.emplace_back([this, i] {
+                std::mt19937 rng(options_.seed + static_cast<unsigned>(i));
+                while (Clock::now() < end_) {
+                    call(rng, Clock::now());
+                }
+            });
+        }
+        for (auto& t : callers) t.join();
+    }
+
+    void runOpen() {
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::deque<Clock::time_point> arrivals;
+        bool done = false;
+
+        std::vector<std::thread> callers;
+        for (std::size_t i = 0; i < options_.concurrency; ++i) {
+            callers.emplace_back([&, i] {
+                std::mt19937 rng(options_.seed + static_cast<unsigned>(i));
+                while (true) {
+                    Clock::time_point scheduled;
+                    {
+                        std::unique_lock<std::mutex> lock(mutex);
+                        cv.wait(lock, [&] { return done || !arrivals.empty(); });
+                        if (arrivals.empty()) return;
+                        scheduled = arrivals.front();
+                        arrivals.pop_front();
+                    }
+                    call(rng, scheduled);
+                }
+            });
+        }
+
+        // Poisson arrivals at the requested rate
+        std::mt19937 rng(options_.seed);
+        std::exponential_distribution<double> gap(std::max(options_.rate, 1e-3));
+        auto next = Clock::now();
+        while (next < end_) {
+            std::this_thread::sleep_until(next);
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                arrivals.push_back(next);
+            }
+            cv.notify_one();
+            next += toDuration(gap(rng));
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            unsent_ = arrivals.size(); // the server never caught up with these
+            arrivals.clear();
+            done = true;
+        }
+        cv.notify_all();
+        for (auto& t : callers) t.join();
+    }
+
+    // Sends one batch scheduled for the given time and records the outcome
+    // if it falls inside the measured window. Image bytes are counted as
+    // encoded, without the uniqueness suffix.
+    void call(std::mt19937& rng, Clock::time_point scheduled) {
+        ocr::BatchRequest request;
+        std::vector<const SyntheticImage*> sent;
+        std::vector<std::size_t> sentBytes;
+        for (std::size_t i = 0; i < options_.batch; ++i) {
+            const SyntheticImage& image = corpus_[pick_(rng)];
+            ocr::ImageTask* task = request.add_tasks();
+            task->set_id(static_cast<int>(i + 1));
+            std::string* data = task->mutable_image_data();
+            *data = image.encoded;
+            sentBytes.push_back(image.encoded.size());
+            if (options_.uniqueImages) {
+                // Decoders stop at the end of the image, but the bytes, and
+                // with them the server's cache key, differ on every send
+                const std::uint64_t n = sequence_.fetch_add(1, std::memory_order_relaxed);
+                data->append(reinterpret_cast<const char*>(&n), sizeof(n));
+            }
+            sent.push_back(&image);
+        }
+
+        const bool measured = scheduled >= measureFrom_ && scheduled < end_;
+        auto returned = [this] {
+            const std::int64_t us = std::chrono::duration_cast<std::chrono::microseconds>(
+                Clock::now() - measureFrom_).count();
+            std::int64_t last = stats_.lastReturnUs.load();
+            while (us > last && !stats_.lastReturnUs.compare_exchange_weak(last, us)) {
+            }
+        };
+
+        ocr::BatchResponse reply;
+        try {
+            reply = client_.sendBatch(request);
+        }
+        catch (const RpcError& ex) {
+            if (!measured) return;
+            returned();
+            ++stats_.calls;
+            if (ex.code() == grpc::StatusCode::RESOURCE_EXHAUSTED) ++stats_.rejected;
+            else if (ex.code() == grpc::StatusCode::DEADLINE_EXCEEDED) ++stats_.timeouts;
+            else ++stats_.failed;
+            return;
+        }
+        catch (const std::exception&) {
+            if (measured) {
+                returned();
+                ++stats_.calls;
+                ++stats_.failed;
+            }
+            return;
+        }
+        if (!measured) return;
+        returned();
+
+        const auto latency = std::chrono::duration_cast<std::chrono::microseconds>(
+            Clock::now() - scheduled).count();
+        stats_.callLatency.record(latency);
+        ++stats_.calls;
+
+        for (const auto& result : reply.results()) {
+            const int index = result.id() - 1;
+            if (index < 0 || index >= static_cast<int>(sent.size())) continue;
+            if (!result.text().empty() && result.text()[0] == '['
+                && (result.text().rfind("[ERROR]", 0) == 0
+                    || result.text().rfind("[TIMEOUT]", 0) == 0
+                    || result.text().rfind("[REJECTED]", 0) == 0)) {
+                ++stats_.imageErrors;
+                continue;
+            }
+            ++stats_.images;
+            stats_.bytes += sentBytes[index];
+            stats_.serverLatency.record(result.timings().total_us());
+
+            if (options_.check) {
+                const double accuracy = character_accuracy(sent[index]->text, result.text());
+                std::lock_guard<std::mutex> lock(stats_.accuracyMutex);
+                stats_.accuracySum += accuracy;
+                ++stats_.accuracyCount;
+            }
+        }
+    }
+
+    const LoadGenOptions options_;
+    const std::vector<SyntheticImage> corpus_;
+    GrpcOcrClient client_; // the stub is safe to share between callers
+    std::discrete_distribution<std::size_t> pick_;
+
+    Clock::time_point measureFrom_;
+    Clock::time_point end_;
+    std::atomic<std::uint64_t> sequence_{ 0 };
+    std::size_t unsent_ = 0;
+    mutable RunStats stats_;
+};
+
+static std::string format_ms(std::uint64_t us) {
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(1) << us / 1000.0 << "ms";
+    return out.str();
+}
+
+void LoadGenerator::report(std::ostream& out) const {
+    const double seconds = std::max(options_.durationS, stats_.lastReturnUs / 1e6);
+    const HistogramSnapshot calls = stats_.callLatency.snapshot();
+    const HistogramSnapshot server = stats_.serverLatency.snapshot();
+
+    out << "\n" << (options_.openLoop ? "open" : "closed") << " loop, "
+        << options_.concurrency << " callers, batch " << options_.batch
+        << (options_.openLoop ? ", " + std::to_string(options_.rate) + " batches/s" : "")
+        << ", " << options_.durationS << "s of calls after " << options_.warmupS
+        << "s warm-up, " << seconds << "s until the last returned\n";
+
+    out << "calls:      " << stats_.calls << " (rejected " << stats_.rejected
+        << ", timed out " << stats_.timeouts << ", failed " << stats_.failed;
+    if (options_.openLoop) out << ", never sent " << unsent_;
+    out << ")\n";
+
+    out << std::fixed << std::setprecision(1);
+    out << "images:     " << stats_.images << " ok, " << stats_.imageErrors << " errors\n";
+    out << "throughput: " << stats_.images / seconds << " images/s, "
+        << std::setprecision(2) << stats_.bytes / seconds / (1024.0 * 1024.0) << " MB/s\n";
+
+    out << "call latency:   p50 " << format_ms(calls.percentile(0.50))
+        << "  p95 " << format_ms(calls.percentile(0.95))
+        << "  p99 " << format_ms(calls.percentile(0.99))
+        << "  p999 " << format_ms(calls.percentile(0.999))
+        << "  max " << format_ms(calls.max) << "\n";
+    out << "server / image: p50 " << format_ms(server.percentile(0.50))
+        << "  p95 " << format_ms(server.percentile(0.95))
+        << "  p99 " << format_ms(server.percentile(0.99))
+        << "  p999 " << format_ms(server.percentile(0.999))
+        << "  max " << format_ms(server.max) << "\n";
+
+    if (options_.check) {
+        std::lock_guard<std::mutex> lock(stats_.accuracyMutex);
+        out << std::setprecision(2) << "accuracy:   "
+            << (stats_.accuracyCount ? 100.0 * stats_.accuracySum / stats_.accuracyCount : 0.0)
+            << "% of characters over " << stats_.accuracyCount << " images\n";
+    }
+}
+
+static void print_usage(std::ostream& out = std::cout) {
+    out <<
+        "OCRLoadGen [options]\n"
+        "  --server HOST:PORT   default localhost:50051\n"
+        "  --mode closed|open   default closed\n"
+        "  --concurrency N      callers (closed) or max calls in flight (open); default 4\n"
+        "  --rate R             open loop: batches per second; default 10\n"
+        "  --batch N            images per call; default 1\n"
+        "  --duration S         measured seconds; default 30\n"
+        "  --warmup S           unmeasured seconds first; default 5\n"
+        "  --mix WxH[:w],...    page sizes and their weights; default 1240x1754\n"
+        "  --format png|jpg     default png\n"
+        "  --corpus N           distinct pages to render; default 32\n"
+        "  --deadline-ms MS     per-call deadline; default none\n"
+        "  --check              score recognized text against the rendered text\n"
+        "  --repeat-images      send identical bytes, so the server's cache can hit\n"
+        "  --seed N\n";
+}
+
+// Throws UsageError for anything it does not understand, so a typo does
+// not quietly measure something other than what was asked for.
+static LoadGenOptions parse_options(std::vector<std::string> argList) {
+    LoadGenOptions options;
+    ArgReader args(std::move(argList));
+    while (args.next()) {
+        const std::string& arg = args.flag();
+        if (arg == "--server") options.server = args.value();
+        else if (arg == "--mode") {
+            const std::string& mode = args.value();
+            if (mode != "closed" && mode != "open") args.invalid(mode, "closed or open");
+            options.openLoop = mode == "open";
+        }
+        else if (arg == "--concurrency") {
+            options.concurrency = static_cast<std::size_t>(args.integer(1, 100000));
+        }
+        else if (arg == "--rate") options.rate = args.number(0.001, 1e6);
+        else if (arg == "--batch") options.batch = static_cast<std::size_t>(args.integer(1, 100000));
+        else if (arg == "--duration") options.durationS = args.number(1.0, 1e6);
+        else if (arg == "--warmup") options.warmupS = args.number(0.0, 1e6);
+        else if (arg == "--mix") options.mix = args.value();
+        else if (arg == "--format") {
+            const std::string& format = args.value();
+            if (format != "png" && format != "jpg") args.invalid(format, "png or jpg");
+            options.format = "." + format;
+        }
+        else if (arg == "--corpus") options.corpus = static_cast<std::size_t>(args.integer(1, 100000));
+        else if (arg == "--deadline-ms") options.deadlineMs = args.integer(0, 24LL * 3600 * 1000);
+        else if (arg == "--check") options.check = true;
+        else if (arg == "--repeat-images") options.uniqueImages = false;
+        else if (arg == "--seed") options.seed = static_cast<unsigned>(args.integer(0, 4294967295LL));
+        else args.unknown();
+    }
+    return options;
+}
+
+int main(int argc, char* argv[]) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            print_usage();
+            return 0;
+        }
+    }
+
+    LoadGenOptions options;
+    try {
+        options = parse_options(std::vector<std::string>(argv + 1, argv + argc));
+    }
+    catch (const UsageError& ex) {
+        std::cerr << "OCRLoadGen: " << ex.what() << "\n\n";
+        print_usage(std::cerr);
+        return 2;
+    }
+
+    std::vector<ImageSpec> specs;
+    try {
+        specs = parse_image_mix(options.mix);
+    }
+    catch (const std::exception& ex) {
+        std::cerr << ex.what() << "\n";
+        return 1;
+    }
+
+    // Render the corpus up front so the callers only copy bytes. Each size
+    // gets its share of the corpus; its weight is applied when picking.
+    std::mt19937 rng(options.seed);
+    std::vector<SyntheticImage> corpus;
+    const std::size_t perSpec = std::max<std::size_t>(1, options.corpus / specs.size());
+    for (const auto& spec : specs) {
+        for (std::size_t i = 0; i < perSpec; ++i) {
+            ImageSpec share = spec;
+            share.weight = spec.weight / perSpec;
+            corpus.push_back(render_page(share, random_page_text(rng, spec), options.format));
+        }
+        std::cout << "Rendered " << perSpec << " pages of " << spec.width << "x" << spec.height
+            << " (" << corpus.back().encoded.size() / 1024 << " KB each)\n";
+    }
+
+    LoadGenerator generator(options, std::move(corpus));
+    std::cout << "Running against " << options.server << "...\n";
+    generator.run();
+    generator.report(std::cout);
+    return 0;
+}
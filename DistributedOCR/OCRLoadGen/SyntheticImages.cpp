@@ -0,0 +1,170 @@
+#include "SyntheticImages.h"
+
+#include <opencv2/opencv.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <stdexcept>
+
+// Short, common words in a font Tesseract reads reliably, so a clean page
+// should come back close to verbatim.
+static const char* const WORDS[] = {
+    "the", "quick", "brown", "fox", "jumps", "over", "lazy", "dog", "invoice",
+    "total", "amount", "date", "number", "order", "customer", "account",
+    "payment", "due", "balance", "service", "report", "summary", "page",
+    "section", "table", "value", "price", "quantity", "item", "address",
+    "street", "city", "country", "phone", "email", "office", "company",
+    "contract", "signed", "received", "shipped", "delivery", "status",
+    "approved", "pending", "closed", "open", "north", "south", "east", "west",
+    "2024", "1998", "42", "315", "7.50", "100.00", "No.", "Ref:", "ID:",
+};
+
+// Text layout relative to the page width: characters per line, and line
+// pitch as a multiple of the text height.
+static const int CHARS_PER_LINE = 60;
+static const double LINE_PITCH = 1.8;
+static const double MARGIN = 0.06; // of the page width, on every side
+
+// Font size and line placement for a page of spec's size.
+struct PageLayout {
+    double scale = 1.0;
+    int thickness = 1;
+    int margin = 0;
+    int textHeight = 0;
+    int lineHeight = 0;
+    int lineCount = 1;
+};
+
+static PageLayout page_layout(const ImageSpec& spec) {
+    PageLayout layout;
+    layout.margin = static_cast<int>(spec.width * MARGIN);
+
+    // Scale the font so a full line of CHARS_PER_LINE characters fills the
+    // usable width
+    int baseline = 0;
+    const cv::Size unit = cv::getTextSize(std::string(CHARS_PER_LINE, 'n'),
+        cv::FONT_HERSHEY_SIMPLEX, 1.0, 1, &baseline);
+    layout.scale = (spec.width - 2.0 * layout.margin) / std::max(1, unit.width);
+    layout.thickness = std::max(1, static_cast<int>(layout.scale * 1.5 + 0.5));
+    layout.textHeight = std::max(1, static_cast<int>(unit.height * layout.scale));
+    layout.lineHeight = std::max(1, static_cast<int>(layout.textHeight * LINE_PITCH));
+    layout.lineCount = std::max(1,
+        (spec.height - 2 * layout.margin - layout.textHeight) / layout.lineHeight + 1);
+    return layout;
+}
+
+std::vector<ImageSpec> parse_image_mix(const std::string& mix) {
+    std::vector<ImageSpec> specs;
+    std::size_t start = 0;
+    while (start < mix.size()) {
+        std::size_t end = mix.find(',', start);
+        if (end == std::string::npos) end = mix.size();
+        const std::string item = mix.substr(start, end - start);
+        start = end + 1;
+        if (item.empty()) continue;
+
+        ImageSpec spec;
+        const std::size_t x = item.find('x');
+        const std::size_t colon = item.find(':');
+        try {
+            if (x == std::string::npos) throw std::invalid_argument(item);
+            spec.width = std::stoi(item.substr(0, x));
+            spec.height = std::stoi(item.substr(x + 1, colon - x - 1));
+            if (colon != std::string::npos) spec.weight = std::stod(item.substr(colon + 1));
+        }
+        catch (const std::exception&) {
+            throw std::invalid_argument("Bad image size '" + item + "', expected WxH[:weight]");
+        }
+        if (spec.width < 64 || spec.height < 64 || spec.weight <= 0.0) {
+            throw std::invalid_argument("Bad image size '" + item + "'");
+        }
+        specs.push_back(spec);
+    }
+    if (specs.empty()) throw std::invalid_argument("Empty image mix");
+    return specs;
+}
+
+std::string random_page_text(std::mt19937& rng, const ImageSpec& spec) {
+    const int lineCount = page_layout(spec).lineCount;
+
+    std::uniform_int_distribution<std::size_t> pick(0, std::size(WORDS) - 1);
+    std::string text;
+    for (int line = 0; line < lineCount; ++line) {
+        std::string current;
+        while (true) {
+            const std::string word = WORDS[pick(rng)];
+            const std::size_t next = current.size() + (current.empty() ? 0 : 1) + word.size();
+            if (next > static_cast<std::size_t>(CHARS_PER_LINE) - 4) break;
+            if (!current.empty()) current += ' ';
+            current += word;
+        }
+        if (line > 0) text += '\n';
+        text += current;
+    }
+    return text;
+}
+
+SyntheticImage render_page(const ImageSpec& spec, const std::string& text,
+    const std::string& format) {
+    const PageLayout layout = page_layout(spec);
+
+    cv::Mat page(spec.height, spec.width, CV_8UC1, cv::Scalar(255));
+    int y = layout.margin + layout.textHeight; // putText's origin is the baseline
+    std::size_t start = 0;
+    while (start <= text.size()) {
+        std::size_t end = text.find('\n', start);
+        if (end == std::string::npos) end = text.size();
+        cv::putText(page, text.substr(start, end - start), cv::Point(layout.margin, y),
+            cv::FONT_HERSHEY_SIMPLEX, layout.scale, cv::Scalar(0), layout.thickness,
+            cv::LINE_AA);
+        y += layout.lineHeight;
+        start = end + 1;
+    }
+
+    SyntheticImage image;
+    image.spec = spec;
+    image.text = text;
+    std::vector<uchar> bytes;
+    std::vector<int> params;
+    if (format == ".jpg") params = { cv::IMWRITE_JPEG_QUALITY, 90 };
+    if (!cv::imencode(format, page, bytes, params)) {
+        throw std::runtime_error("Could not encode synthetic page as " + format);
+    }
+    image.encoded.assign(bytes.begin(), bytes.end());
+    return image;
+}
+
+// Lower-cased, with every run of whitespace turned into one space.
+static std::string normalize(const std::string& text) {
+    std::string out;
+    bool space = false;
+    for (unsigned char c : text) {
+        if (std::isspace(c)) {
+            space = !out.empty();
+            continue;
+        }
+        if (space) out += ' ';
+        space = false;
+        out += static_cast<char>(std::tolower(c));
+    }
+    return out;
+}
+
+double character_accuracy(const std::string& truth, const std::string& recognized) {
+    const std::string a = normalize(truth);
+    const std::string b = normalize(recognized);
+    if (a.empty()) return b.empty() ? 1.0 : 0.0;
+
+    // Levenshtein distance, two rows
+    std::vector<std::size_t> prev(b.size() + 1), cur(b.size() + 1);
+    for (std::size_t j = 0; j <= b.size(); ++j) prev[j] = j;
+    for (std::size_t i = 1; i <= a.size(); ++i) {
+        cur[0] = i;
+        for (std::size_t j = 1; j <= b.size(); ++j) {
+            const std::size_t substitute = prev[j - 1] + (a[i - 1] == b[j - 1] ? 0 : 1);
+            cur[j] = std::min({ prev[j] + 1, cur[j - 1] + 1, substitute });
+        }
+        std::swap(prev, cur);
+    }
+    return std::max(0.0, 1.0 - static_cast<double>(prev[b.size()]) / a.size());
+}
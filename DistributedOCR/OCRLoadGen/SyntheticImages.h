@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+// Page size of generated images; weight is its share of the mix.
+struct ImageSpec {
+    int width = 0;
+    int height = 0;
+    double weight = 1.0;
+};
+
+// An encoded page together with the text rendered onto it.
+struct SyntheticImage {
+    ImageSpec spec;
+    std::string text;    // ground truth, lines separated by '\n'
+    std::string encoded; // PNG or JPEG bytes
+};
+
+// "1240x1754:3,2480x3508" -> two specs weighted 3:1. Throws
+// std::invalid_argument on anything else.
+std::vector<ImageSpec> parse_image_mix(const std::string& mix);
+
+// Lines of random dictionary words, sized so they stay legible on a page
+// of the given width when rendered by render_page().
+std::string random_page_text(std::mt19937& rng, const ImageSpec& spec);
+
+// Renders text black on white with the pages' line spacing and encodes it
+// (format is ".png" or ".jpg"). Text size scales with the page width, so
+// every resolution carries the same text at a different pixel density.
+SyntheticImage render_page(const ImageSpec& spec, const std::string& text,
+    const std::string& format);
+
+// Character accuracy of recognized against truth, 0..1: one minus their
+// edit distance over the truth's length, both with runs of whitespace
+// collapsed.
+double character_accuracy(const std::string& truth, const std::string& recognized);
@@ -0,0 +1,287 @@
+#include "AsyncBatchServer.h"
+
+#include <grpcpp/alarm.h>
+
+#include "CancellationToken.h"
+#include "CpuTopology.h"
+#include "Logger.h"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using grpc::ServerAsyncResponseWriter;
+using grpc::ServerCompletionQueue;
+using grpc::ServerContext;
+using grpc::Status;
+
+using ocr::BatchRequest;
+using ocr::BatchResponse;
+using ocr::BatchResult;
+
+namespace {
+
+class BatchCall;
+
+// Completion-queue tag. A call owns one tag per kind of event it waits on.
+struct CallTag {
+    enum class Kind { Request, Alarm, Done, Finish };
+
+    BatchCall* call;
+    Kind kind;
+};
+
+// One ProcessBatch RPC.
+//
+//   Request  -> waiting for a client; on arrival the tasks are enqueued and
+//               an alarm is armed for the call's deadline.
+//   Pending  -> worker callbacks fill in results; the last one (or the
+//               alarm, whichever comes first) sends the response.
+//   Finish   -> waiting for the response to be written.
+//
+// Independently, the Done tag fires when the RPC ends; if the client
+// cancelled, the call's token is cancelled so its queued jobs are dropped.
+//
+// The object deletes itself once the Finish, alarm and Done tags and every
+// worker callback have come back, since each of those still points at it.
+class BatchCall {
+public:
+    BatchCall(AsyncOCRService& service, ServerCompletionQueue* cq, OcrWorkerPool& pool)
+        : service_(service), cq_(cq), pool_(pool), responder_(&ctx_) {
+        // Only delivered if the call actually starts
+        ctx_.AsyncNotifyWhenDone(&doneTag_);
+        service_.RequestProcessBatch(&ctx_, &request_, &responder_, cq_, cq_, &requestTag_);
+    }
+
+    void proceed(CallTag::Kind kind, bool ok) {
+        switch (kind) {
+        case CallTag::Kind::Request:
+            if (!ok) {
+                // Completion queue is shutting down; nothing was started.
+                delete this;
+                return;
+            }
+            new BatchCall(service_, cq_, pool_);
+            start();
+            break;
+
+        case CallTag::Kind::Alarm:
+            // ok == true: deadline reached. ok == false: cancelled because
+            // every task finished first.
+            if (ok) {
+                onTimeout();
+            }
+            release();
+            break;
+
+        case CallTag::Kind::Done:
+            if (ctx_.IsCancelled()) {
+                LOG_INFO("client cancelled batch; dropping its jobs");
+                callToken_->cancel();
+            }
+            release();
+            break;
+
+        case CallTag::Kind::Finish:
+            release();
+            break;
+        }
+    }
+
+private:
+    void start() {
+        const int taskCount = request_.tasks_size();
+        LOG_DEBUG("batch received").kv("tasks", taskCount).kv("async", true);
+
+        if (taskCount == 0) {
+            refs_ = 2; // Finish + Done
+            finished_ = true;
+            responder_.FinishWithError(
+                Status(grpc::StatusCode::INVALID_ARGUMENT, "BatchRequest.tasks is empty"),
+                &finishTag_);
+            return;
+        }
+
+        results_.resize(taskCount);
+        done_.assign(taskCount, false);
+        remaining_ = taskCount;
+
+        // Finish + Done + alarm + one per task. Set up front so an early
+        // callback cannot drop the count to zero while we are still enqueuing.
+        refs_ = 3 + taskCount;
+
+        // Every job shares the call's deadline (the client's, if it sent
+        // one). Arm the alarm for it before enqueuing so the last callback
+        // always has something to cancel.
+        callToken_ = std::make_shared<CancellationToken>(job_deadline(ctx_));
+        alarm_.Set(cq_,
+            std::chrono::system_clock::now()
+                + (callToken_->deadline() - CancellationToken::Clock::now()),
+            &alarmTag_);
+
+        // request_ is ours, so the image bytes are moved, not copied, into
+        // the pool. Only ids are read from it after this point.
+        std::vector<OcrTask> tasks;
+        tasks.reserve(taskCount);
+        for (int i = 0; i < taskCount; ++i) {
+            auto* task = request_.mutable_tasks(i);
+            tasks.push_back(OcrTask{ task->id(), std::move(*task->mutable_image_data()),
+                ocr_settings(*task) });
+        }
+
+        try {
+            pool_.enqueueBatch(std::move(tasks),
+                [this](std::size_t index, std::exception_ptr error, OcrResult result) {
+                    onTaskDone(static_cast<int>(index), error, std::move(result));
+                },
+                callToken_, job_class(ctx_, &request_));
+        }
+        catch (...) {
+            // Refused as a whole, so no task callback will ever run
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                finished_ = true;
+            }
+            // Drop the per-task references; the alarm may already have
+            // fired, so adjust rather than reset the count
+            refs_ -= taskCount;
+            alarm_.Cancel();
+            responder_.FinishWithError(
+                batch_rejected_status(ctx_, std::current_exception()), &finishTag_);
+        }
+    }
+
+    void onTaskDone(int index, std::exception_ptr error, OcrResult result) {
+        bool finishNow = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!finished_) {
+                fill_batch_outcome(&results_[index], request_.tasks(index).id(),
+                    error, result);
+                done_[index] = true;
+
+                if (--remaining_ == 0) {
+                    finished_ = true;
+                    finishNow = true;
+                }
+            }
+        }
+
+        if (finishNow) {
+            alarm_.Cancel();
+            sendReply();
+        }
+        release();
+    }
+
+    void onTimeout() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (finished_) return;
+            finished_ = true;
+
+            // Anything still queued or running is no longer wanted
+            callToken_->cancel();
+
+            for (std::size_t i = 0; i < results_.size(); ++i) {
+                if (done_[i]) continue;
+                const int id = request_.tasks(static_cast<int>(i)).id();
+                LOG_WARN("task timed out").kv("id", id);
+                fill_batch_error(&results_[i], id, "[TIMEOUT] OCR took too long");
+            }
+        }
+        sendReply();
+    }
+
+    // Called exactly once, by whoever set finished_.
+    void sendReply() {
+        for (auto& r : results_) {
+            *reply_.add_results() = std::move(r);
+        }
+        LOG_DEBUG("batch complete").kv("results", reply_.results_size()).kv("async", true);
+        responder_.Finish(reply_, Status::OK, &finishTag_);
+    }
+
+    void release() {
+        if (refs_.fetch_sub(1) == 1) {
+            delete this;
+        }
+    }
+
+    AsyncOCRService& service_;
+    ServerCompletionQueue* cq_;
+    OcrWorkerPool& pool_;
+
+    ServerContext ctx_;
+    BatchRequest request_;
+    BatchResponse reply_;
+    ServerAsyncResponseWriter<BatchResponse> responder_;
+    grpc::Alarm alarm_;
+    std::shared_ptr<CancellationToken> callToken_ = std::make_shared<CancellationToken>();
+
+    CallTag requestTag_{ this, CallTag::Kind::Request };
+    CallTag alarmTag_{ this, CallTag::Kind::Alarm };
+    CallTag doneTag_{ this, CallTag::Kind::Done };
+    CallTag finishTag_{ this, CallTag::Kind::Finish };
+
+    std::mutex mutex_;
+    std::vector<BatchResult> results_;
+    std::vector<bool> done_;
+    int remaining_ = 0;
+    bool finished_ = false;
+    std::atomic<int> refs_{ 1 };
+};
+
+} // namespace
+
+AsyncBatchServer::AsyncBatchServer(grpc::ServerBuilder& builder, AsyncOCRService& service,
+    OcrWorkerPool& pool, std::size_t numCqThreads)
+    : service_(service), pool_(pool) {
+    if (numCqThreads == 0) numCqThreads = 1;
+    for (std::size_t i = 0; i < numCqThreads; ++i) {
+        cqs_.push_back(builder.AddCompletionQueue());
+    }
+}
+
+AsyncBatchServer::~AsyncBatchServer() {
+    shutdown();
+}
+
+void AsyncBatchServer::start() {
+    for (auto& cq : cqs_) {
+        // Seed one outstanding request per queue; each accepted call
+        // replaces itself with a fresh one.
+        new BatchCall(service_, cq.get(), pool_);
+        pollers_.emplace_back(&AsyncBatchServer::pollLoop, this, cq.get());
+    }
+
+    LOG_INFO("async ProcessBatch started").kv("completion_queues", cqs_.size());
+}
+
+void AsyncBatchServer::shutdown() {
+    if (stopped_) return;
+    stopped_ = true;
+
+    for (auto& cq : cqs_) {
+        cq->Shutdown();
+    }
+    for (auto& t : pollers_) {
+        if (t.joinable()) t.join();
+    }
+}
+
+void AsyncBatchServer::pollLoop(ServerCompletionQueue* cq) {
+    if (!pollerCpus_.empty() && !pin_current_thread(pollerCpus_)) {
+        LOG_WARN("could not pin completion-queue thread").kv("cpus", format_cpu_list(pollerCpus_));
+    }
+
+    void* tag = nullptr;
+    bool ok = false;
+    while (cq->Next(&tag, &ok)) {
+        auto* callTag = static_cast<CallTag*>(tag);
+        callTag->call->proceed(callTag->kind, ok);
+    }
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <grpcpp/grpcpp.h>
+#include "ocr_service.grpc.pb.h"
+
+#include "OcrServiceImpl.h"
+#include "OcrWorkerPool.h"
+
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// ProcessBatch is served from completion queues; every other method keeps
+// its synchronous handler from OCRServiceImpl.
+using AsyncOCRService = ocr::OCRService::WithAsyncMethod_ProcessBatch<OCRServiceImpl>;
+
+// Completion-queue driven ProcessBatch. Each in-flight batch is a small
+// state machine (see BatchCall in AsyncBatchServer.cpp) that is completed by
+// OcrWorkerPool callbacks, so waiting batches hold no threads.
+class AsyncBatchServer {
+public:
+    // Adds the completion queues to the builder; call before BuildAndStart().
+    AsyncBatchServer(grpc::ServerBuilder& builder, AsyncOCRService& service,
+        OcrWorkerPool& pool, std::size_t numCqThreads);
+    ~AsyncBatchServer();
+
+    // Restricts the polling threads to these logical processors (see
+    // CpuTopology.h). Call before start().
+    void setPollerCpus(std::vector<int> cpus) { pollerCpus_ = std::move(cpus); }
+
+    // Starts polling. Call after BuildAndStart().
+    void start();
+
+    // Drains and joins the pollers. The server must already be shut down.
+    void shutdown();
+
+private:
+    void pollLoop(grpc::ServerCompletionQueue* cq);
+
+    AsyncOCRService& service_;
+    OcrWorkerPool& pool_;
+    std::vector<std::unique_ptr<grpc::ServerCompletionQueue>> cqs_;
+    std::vector<std::thread> pollers_;
+    std::vector<int> pollerCpus_;
+    bool stopped_ = false;
+};
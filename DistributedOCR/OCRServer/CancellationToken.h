@@ -0,0 +1,53 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+
+// Lets an RPC tell the worker pool that nobody is waiting for a job any more.
+// A token expires at its deadline and can be cancelled early when the client
+// goes away or stops waiting; a child token is also cancelled with its
+// parent (used by streams, where each job has its own deadline under one
+// call-wide token). Workers drop cancelled jobs before starting them, and
+// Tesseract polls the token while it recognizes (see run_ocr_on_bytes). The
+// deadline also orders the worker pool's queue.
+class CancellationToken {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    CancellationToken() = default;
+
+    explicit CancellationToken(Clock::time_point deadline)
+        : deadline_(deadline) {
+    }
+
+    CancellationToken(std::shared_ptr<const CancellationToken> parent,
+        Clock::time_point deadline)
+        : parent_(std::move(parent)), deadline_(deadline) {
+    }
+
+    void cancel() { cancelled_.store(true, std::memory_order_relaxed); }
+
+    bool isCancelled() const {
+        if (cancelled_.load(std::memory_order_relaxed)) return true;
+        if (deadline_ != Clock::time_point::max() && Clock::now() >= deadline_) return true;
+        return parent_ && parent_->isCancelled();
+    }
+
+    Clock::time_point deadline() const { return deadline_; }
+
+private:
+    std::atomic<bool> cancelled_{ false };
+    std::shared_ptr<const CancellationToken> parent_;
+    Clock::time_point deadline_ = Clock::time_point::max();
+};
+
+using CancelTokenPtr = std::shared_ptr<const CancellationToken>;
+
+// Thrown (through the job's future/callback) for jobs that were dropped or
+// aborted because their token was cancelled.
+class OcrCancelledError : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
@@ -0,0 +1,81 @@
+#include "CommandLine.h"
+
+#include <cmath>
+#include <limits>
+#include <sstream>
+
+ArgReader::ArgReader(std::vector<std::string> args) : args_(std::move(args)) {
+}
+
+bool ArgReader::next() {
+    if (next_ >= args_.size()) return false;
+    flag_ = next_++;
+    return true;
+}
+
+const std::string& ArgReader::value() {
+    if (next_ >= args_.size()) {
+        throw UsageError(flag() + " needs a value");
+    }
+    return args_[next_++];
+}
+
+std::size_t ArgReader::count() {
+    const std::string& text = value();
+    // stoull would accept "-1" and wrap it around
+    const bool digits = !text.empty()
+        && text.find_first_not_of("0123456789") == std::string::npos;
+    unsigned long long parsed = 0;
+    try {
+        if (digits) parsed = std::stoull(text);
+    }
+    catch (const std::exception&) {
+        invalid(text, "a whole number");
+    }
+    if (!digits || parsed > std::numeric_limits<std::size_t>::max()) {
+        invalid(text, "a whole number");
+    }
+    return static_cast<std::size_t>(parsed);
+}
+
+long long ArgReader::integer(long long min, long long max) {
+    const std::string& text = value();
+    const std::string expected = "a whole number from " + std::to_string(min)
+        + " to " + std::to_string(max);
+    std::size_t used = 0;
+    long long parsed = 0;
+    try {
+        parsed = std::stoll(text, &used);
+    }
+    catch (const std::exception&) {
+        invalid(text, expected);
+    }
+    if (used != text.size() || parsed < min || parsed > max) invalid(text, expected);
+    return parsed;
+}
+
+double ArgReader::number(double min, double max) {
+    const std::string& text = value();
+    std::ostringstream expected;
+    expected << "a number from " << min << " to " << max;
+    std::size_t used = 0;
+    double parsed = 0.0;
+    try {
+        parsed = std::stod(text, &used);
+    }
+    catch (const std::exception&) {
+        invalid(text, expected.str());
+    }
+    if (used != text.size() || !std::isfinite(parsed) || parsed < min || parsed > max) {
+        invalid(text, expected.str());
+    }
+    return parsed;
+}
+
+void ArgReader::unknown() const {
+    throw UsageError("unknown option " + flag());
+}
+
+void ArgReader::invalid(const std::string& value, const std::string& expected) const {
+    throw UsageError(flag() + ": expected " + expected + ", got '" + value + "'");
+}
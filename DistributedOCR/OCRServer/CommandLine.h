@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// A command line (or config file) that cannot be used: an unknown option, a
+// flag missing its value, or a value that does not parse or is out of
+// range. main() prints it with the usage and exits non-zero.
+class UsageError : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+// Walks "--flag [value]" arguments for an option loop. The value getters
+// consume the argument after the current flag and throw UsageError,
+// naming the flag, when it is missing or malformed.
+class ArgReader {
+public:
+    explicit ArgReader(std::vector<std::string> args);
+
+    // Moves to the next flag; false when there are none left.
+    bool next();
+    const std::string& flag() const { return args_[flag_]; }
+
+    const std::string& value();
+    std::size_t count();                           // a whole number >= 0
+    long long integer(long long min, long long max);
+    double number(double min, double max);         // finite
+
+    // Throws UsageError for the current flag.
+    [[noreturn]] void unknown() const;
+    [[noreturn]] void invalid(const std::string& value, const std::string& expected) const;
+
+private:
+    std::vector<std::string> args_;
+    std::size_t flag_ = 0;
+    std::size_t next_ = 0; // first argument not yet consumed
+};
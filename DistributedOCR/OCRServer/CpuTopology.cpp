@@ -0,0 +1,363 @@
+#include "CpuTopology.h"
+
+#include <algorithm>
+#include <exception>
+#include <map>
+#include <set>
+#include <sstream>
+#include <thread>
+#include <tuple>
+#include <utility>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fstream>
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace {
+
+// What the OS reports for one logical processor; coreKey only has to be
+// unique within a package.
+struct RawCpu {
+    int id;
+    int package;
+    int coreKey;
+    int numaNode;
+};
+
+CpuTopology build_topology(std::vector<RawCpu> raw) {
+    std::sort(raw.begin(), raw.end(), [](const RawCpu& a, const RawCpu& b) {
+        return std::tie(a.package, a.id) < std::tie(b.package, b.id);
+    });
+
+    CpuTopology topology;
+    std::map<std::pair<int, int>, int> coreIndex; // (package, coreKey) -> index
+    std::set<int> packages;
+    std::set<int> nodes;
+    for (const RawCpu& r : raw) {
+        auto found = coreIndex.emplace(std::make_pair(r.package, r.coreKey),
+            static_cast<int>(topology.cores.size()));
+        if (found.second) {
+            PhysicalCore core;
+            core.package = r.package;
+            core.numaNode = r.numaNode;
+            topology.cores.push_back(core);
+        }
+        const int core = found.first->second;
+        topology.cores[core].cpus.push_back(r.id);
+
+        LogicalCpu cpu;
+        cpu.id = r.id;
+        cpu.core = core;
+        cpu.package = r.package;
+        cpu.numaNode = r.numaNode;
+        topology.cpus.push_back(cpu);
+        packages.insert(r.package);
+        nodes.insert(r.numaNode);
+    }
+    topology.packages = std::max<std::size_t>(1, packages.size());
+    topology.numaNodes = std::max<std::size_t>(1, nodes.size());
+    return topology;
+}
+
+CpuTopology fallback_topology() {
+    const int n = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    std::vector<RawCpu> raw;
+    for (int i = 0; i < n; ++i) raw.push_back(RawCpu{ i, 0, i, 0 });
+    return build_topology(std::move(raw));
+}
+
+#ifdef _WIN32
+
+// Calls fn(cpuId) for every processor in a group mask.
+template <class Fn>
+void for_each_in_mask(const GROUP_AFFINITY& mask, Fn fn) {
+    for (int bit = 0; bit < 64; ++bit) {
+        if (mask.Mask & (KAFFINITY(1) << bit)) fn(mask.Group * 64 + bit);
+    }
+}
+
+std::vector<RawCpu> read_os_topology() {
+    DWORD length = 0;
+    GetLogicalProcessorInformationEx(RelationAll, nullptr, &length);
+    if (length == 0) return {};
+    std::vector<char> buffer(length);
+    auto* first = reinterpret_cast<SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>(buffer.data());
+    if (!GetLogicalProcessorInformationEx(RelationAll, first, &length)) return {};
+
+    std::map<int, RawCpu> cpus;
+    auto cpu = [&cpus](int id) -> RawCpu& {
+        auto it = cpus.emplace(id, RawCpu{ id, 0, 0, 0 }).first;
+        return it->second;
+    };
+
+    int nextCore = 0;
+    int nextPackage = 0;
+    for (DWORD offset = 0; offset < length;) {
+        auto* info = reinterpret_cast<SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>(buffer.data() + offset);
+        if (info->Relationship == RelationProcessorCore) {
+            const int core = nextCore++;
+            for (WORD g = 0; g < info->Processor.GroupCount; ++g) {
+                for_each_in_mask(info->Processor.GroupMask[g], [&](int id) { cpu(id).coreKey = core; });
+            }
+        }
+        else if (info->Relationship == RelationProcessorPackage) {
+            const int package = nextPackage++;
+            for (WORD g = 0; g < info->Processor.GroupCount; ++g) {
+                for_each_in_mask(info->Processor.GroupMask[g], [&](int id) { cpu(id).package = package; });
+            }
+        }
+        else if (info->Relationship == RelationNumaNode) {
+            const int node = static_cast<int>(info->NumaNode.NodeNumber);
+            for_each_in_mask(info->NumaNode.GroupMask, [&](int id) { cpu(id).numaNode = node; });
+        }
+        offset += info->Size;
+    }
+
+    std::vector<RawCpu> raw;
+    for (const auto& entry : cpus) raw.push_back(entry.second);
+    return raw;
+}
+
+#elif defined(__linux__)
+
+// "0-3,8,10-11" -> { 0, 1, 2, 3, 8, 10, 11 }
+std::vector<int> parse_cpu_list(const std::string& list) {
+    std::vector<int> ids;
+    std::istringstream in(list);
+    std::string range;
+    while (std::getline(in, range, ',')) {
+        const std::size_t dash = range.find('-');
+        try {
+            const int lo = std::stoi(range.substr(0, dash));
+            const int hi = dash == std::string::npos ? lo : std::stoi(range.substr(dash + 1));
+            for (int id = lo; id <= hi; ++id) ids.push_back(id);
+        }
+        catch (const std::exception&) {
+            // trailing newline or garbage; skip it
+        }
+    }
+    return ids;
+}
+
+std::string read_line(const std::string& path) {
+    std::ifstream in(path);
+    std::string line;
+    std::getline(in, line);
+    return line;
+}
+
+int read_int(const std::string& path, int fallback) {
+    try {
+        return std::stoi(read_line(path));
+    }
+    catch (const std::exception&) {
+        return fallback;
+    }
+}
+
+std::vector<RawCpu> read_os_topology() {
+    const std::string sys = "/sys/devices/system/";
+
+    std::map<int, int> nodeOf;
+    for (int node : parse_cpu_list(read_line(sys + "node/online"))) {
+        const std::string list = read_line(sys + "node/node" + std::to_string(node) + "/cpulist");
+        for (int id : parse_cpu_list(list)) nodeOf[id] = node;
+    }
+
+    std::vector<RawCpu> raw;
+    for (int id : parse_cpu_list(read_line(sys + "cpu/online"))) {
+        const std::string topo = sys + "cpu/cpu" + std::to_string(id) + "/topology/";
+        RawCpu cpu;
+        cpu.id = id;
+        cpu.package = read_int(topo + "physical_package_id", 0);
+        cpu.coreKey = read_int(topo + "core_id", id);
+        cpu.numaNode = nodeOf.count(id) ? nodeOf[id] : 0;
+        raw.push_back(cpu);
+    }
+    return raw;
+}
+
+#else
+
+std::vector<RawCpu> read_os_topology() {
+    return {};
+}
+
+#endif
+
+} // namespace
+
+std::string CpuTopology::describe() const {
+    auto count = [](std::size_t n, const char* what) {
+        return std::to_string(n) + " " + what + (n == 1 ? "" : "s");
+    };
+    return count(packages, "package") + ", " + count(numaNodes, "NUMA node") + ", "
+        + count(coreCount(), "core") + ", " + count(logicalCount(), "logical processor");
+}
+
+std::vector<int> CpuTopology::nodeIds() const {
+    std::set<int> nodes;
+    for (const LogicalCpu& cpu : cpus) nodes.insert(cpu.numaNode);
+    return std::vector<int>(nodes.begin(), nodes.end());
+}
+
+std::vector<int> CpuTopology::nodeCpus(int node) const {
+    std::vector<int> ids;
+    for (const LogicalCpu& cpu : cpus) {
+        if (cpu.numaNode == node) ids.push_back(cpu.id);
+    }
+    return ids;
+}
+
+int CpuTopology::nodeOf(int cpuId) const {
+    for (const LogicalCpu& cpu : cpus) {
+        if (cpu.id == cpuId) return cpu.numaNode;
+    }
+    return 0;
+}
+
+CpuTopology detect_cpu_topology() {
+    std::vector<RawCpu> raw = read_os_topology();
+    if (raw.empty()) return fallback_topology();
+    return build_topology(std::move(raw));
+}
+
+const CpuTopology& system_topology() {
+    static const CpuTopology topology = detect_cpu_topology();
+    return topology;
+}
+
+int current_numa_node() {
+    // Node by logical processor id, or empty on a single node
+    static const std::vector<int> nodeOfCpu = [] {
+        const CpuTopology& topology = system_topology();
+        std::vector<int> nodes;
+        if (topology.numaNodes < 2) return nodes;
+        for (const LogicalCpu& cpu : topology.cpus) {
+            if (cpu.id >= static_cast<int>(nodes.size())) nodes.resize(cpu.id + 1, 0);
+            nodes[cpu.id] = cpu.numaNode;
+        }
+        return nodes;
+    }();
+    if (nodeOfCpu.empty()) return 0;
+
+#ifdef _WIN32
+    PROCESSOR_NUMBER processor;
+    GetCurrentProcessorNumberEx(&processor);
+    const int cpu = processor.Group * 64 + processor.Number;
+#elif defined(__linux__)
+    const int cpu = sched_getcpu();
+#else
+    const int cpu = -1;
+#endif
+    if (cpu < 0 || cpu >= static_cast<int>(nodeOfCpu.size())) return 0;
+    return nodeOfCpu[cpu];
+}
+
+CoreAssignment assign_cores(const CpuTopology& topology, std::size_t ioCores,
+    std::size_t numWorkers) {
+    CoreAssignment assignment;
+    const std::size_t cores = topology.coreCount();
+    if (cores == 0 || numWorkers == 0) return assignment;
+
+    // Core indexes taking one from each node in turn; topology order on a
+    // single node
+    std::map<int, std::vector<std::size_t>> byNode;
+    for (std::size_t i = 0; i < cores; ++i) byNode[topology.cores[i].numaNode].push_back(i);
+    std::vector<std::size_t> order;
+    for (std::size_t round = 0; order.size() < cores; ++round) {
+        for (const auto& node : byNode) {
+            if (round < node.second.size()) order.push_back(node.second[round]);
+        }
+    }
+
+    // Always leave the workers at least one core
+    ioCores = std::min(ioCores, cores - 1);
+    for (std::size_t i = 0; i < ioCores; ++i) {
+        const auto& cpus = topology.cores[order[i]].cpus;
+        assignment.ioCpus.insert(assignment.ioCpus.end(), cpus.begin(), cpus.end());
+    }
+
+    const std::size_t workerCores = cores - ioCores;
+    for (std::size_t w = 0; w < numWorkers; ++w) {
+        assignment.workerCpus.push_back(topology.cores[order[ioCores + w % workerCores]].cpus);
+    }
+    return assignment;
+}
+
+bool pin_current_thread(const std::vector<int>& cpus) {
+    if (cpus.empty()) return false;
+#ifdef _WIN32
+    GROUP_AFFINITY affinity = {};
+    affinity.Group = static_cast<WORD>(cpus.front() / 64);
+    for (int id : cpus) {
+        if (id / 64 == affinity.Group) affinity.Mask |= KAFFINITY(1) << (id % 64);
+    }
+    return SetThreadGroupAffinity(GetCurrentThread(), &affinity, nullptr) != 0;
+#elif defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int id : cpus) {
+        if (id >= 0 && id < CPU_SETSIZE) CPU_SET(id, &set);
+    }
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    return false;
+#endif
+}
+
+CpuTimes read_cpu_times() {
+    CpuTimes times;
+#ifdef _WIN32
+    FILETIME idle, kernel, user;
+    if (!GetSystemTimes(&idle, &kernel, &user)) return times;
+    auto value = [](const FILETIME& t) {
+        return static_cast<double>((static_cast<unsigned long long>(t.dwHighDateTime) << 32)
+            | t.dwLowDateTime);
+    };
+    // Kernel time includes idle time
+    times.total = value(kernel) + value(user);
+    times.busy = times.total - value(idle);
+#elif defined(__linux__)
+    // "cpu  user nice system idle iowait irq softirq steal ..."
+    std::ifstream in("/proc/stat");
+    std::string label;
+    in >> label;
+    if (label != "cpu") return times;
+    double fields[8] = {};
+    for (double& field : fields) in >> field;
+    if (!in) return times;
+    for (double field : fields) times.total += field;
+    times.busy = times.total - fields[3] - fields[4];
+#endif
+    return times;
+}
+
+double cpu_utilisation(const CpuTimes& earlier, const CpuTimes& later) {
+    const double total = later.total - earlier.total;
+    if (total <= 0.0) return 0.0;
+    return std::clamp((later.busy - earlier.busy) / total, 0.0, 1.0);
+}
+
+std::string format_cpu_list(const std::vector<int>& cpus) {
+    std::vector<int> sorted(cpus);
+    std::sort(sorted.begin(), sorted.end());
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+
+    std::ostringstream out;
+    for (std::size_t i = 0; i < sorted.size();) {
+        std::size_t j = i;
+        while (j + 1 < sorted.size() && sorted[j + 1] == sorted[j] + 1) ++j;
+        if (i > 0) out << ',';
+        out << sorted[i];
+        if (j > i) out << '-' << sorted[j];
+        i = j + 1;
+    }
+    return out.str();
+}
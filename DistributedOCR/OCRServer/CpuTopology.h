@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// One logical processor (a hardware thread). On Windows the id is
+// group * 64 + index within the group, so machines with more than 64
+// logical processors are covered.
+struct LogicalCpu {
+    int id = 0;
+    int core = 0;     // index into CpuTopology::cores
+    int package = 0;  // socket
+    int numaNode = 0;
+};
+
+// A physical core and its hardware threads (two with SMT/Hyper-Threading).
+struct PhysicalCore {
+    std::vector<int> cpus; // LogicalCpu ids
+    int package = 0;
+    int numaNode = 0;
+};
+
+struct CpuTopology {
+    std::vector<LogicalCpu> cpus;
+    std::vector<PhysicalCore> cores; // ordered by package, then first cpu id
+    std::size_t packages = 1;
+    std::size_t numaNodes = 1;
+
+    std::size_t logicalCount() const { return cpus.size(); }
+    std::size_t coreCount() const { return cores.size(); }
+
+    // e.g. "2 packages, 2 NUMA nodes, 32 cores, 64 logical processors"
+    std::string describe() const;
+
+    // NUMA node ids in ascending order, the logical processors of one, and
+    // the node of a logical processor (0 if unknown).
+    std::vector<int> nodeIds() const;
+    std::vector<int> nodeCpus(int node) const;
+    int nodeOf(int cpuId) const;
+};
+
+// Asks the OS (GetLogicalProcessorInformationEx on Windows, sysfs on
+// Linux). Falls back to one core per hardware_concurrency() thread when the
+// layout cannot be read, so the result always has at least one core.
+CpuTopology detect_cpu_topology();
+
+// detect_cpu_topology() for this machine, run once on first use.
+const CpuTopology& system_topology();
+
+// NUMA node of the processor the calling thread is on at this moment; 0
+// on single-node machines. Cheap enough to call per request.
+int current_numa_node();
+
+// Which cores the server's threads run on. With pinning off both sets are
+// empty and nothing is pinned.
+struct CoreAssignment {
+    std::vector<int> ioCpus;                   // gRPC completion-queue threads, together
+    std::vector<std::vector<int>> workerCpus;  // one core per OCR worker
+};
+
+// Reserves ioCores cores for gRPC I/O and gives each of numWorkers workers
+// a core of its own from the rest. Cores are taken from each NUMA node in
+// turn, so every node gets I/O threads and workers, and workers i and
+// i + 1 sit on different nodes. With fewer cores than that, workers share
+// the remaining cores round-robin and ioCores == 0 lets I/O float over all
+// of them.
+CoreAssignment assign_cores(const CpuTopology& topology, std::size_t ioCores,
+    std::size_t numWorkers);
+
+// Restricts the calling thread to the given logical processors. On Windows
+// a thread can only be pinned within one processor group; cpus outside the
+// first cpu's group are ignored. Returns false (and leaves the thread
+// unpinned) if the OS refuses or cpus is empty.
+bool pin_current_thread(const std::vector<int>& cpus);
+
+// "0-3,8,10-11"
+std::string format_cpu_list(const std::vector<int>& cpus);
+
+// Machine-wide CPU time since boot, summed over all logical processors, in
+// the OS's own unit; only the ratio of two differences means anything.
+// Both zero when the OS does not report it.
+struct CpuTimes {
+    double busy = 0.0;
+    double total = 0.0;
+};
+CpuTimes read_cpu_times();
+
+// Fraction (0..1) of the machine's CPU time that was busy between two
+// readings; 0 if nothing can be told.
+double cpu_utilisation(const CpuTimes& earlier, const CpuTimes& later);
@@ -0,0 +1,122 @@
+#include "ImageProbe.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+static const double INCHES_PER_METER = 39.3701;
+
+// Pixels per metre as stored by PNG and BMP, to whole dots per inch: 600
+// dpi is stored as 23622 and should read back as 600, not 599.998.
+static double ppm_to_dpi(double pixelsPerMeter) {
+    return std::round(pixelsPerMeter / INCHES_PER_METER);
+}
+
+static std::uint32_t read_be16(const unsigned char* p) {
+    return (static_cast<std::uint32_t>(p[0]) << 8) | p[1];
+}
+
+static std::uint32_t read_be32(const unsigned char* p) {
+    return (static_cast<std::uint32_t>(p[0]) << 24) | (static_cast<std::uint32_t>(p[1]) << 16)
+        | (static_cast<std::uint32_t>(p[2]) << 8) | p[3];
+}
+
+static std::uint32_t read_le32(const unsigned char* p) {
+    return (static_cast<std::uint32_t>(p[3]) << 24) | (static_cast<std::uint32_t>(p[2]) << 16)
+        | (static_cast<std::uint32_t>(p[1]) << 8) | p[0];
+}
+
+// Signature, IHDR for the size, then pHYs (if any, always before IDAT).
+static bool probe_png(const unsigned char* data, std::size_t size, ImageInfo& info) {
+    static const unsigned char SIGNATURE[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    if (size < 24 || std::memcmp(data, SIGNATURE, 8) != 0
+        || std::memcmp(data + 12, "IHDR", 4) != 0) {
+        return false;
+    }
+    info.width = static_cast<int>(read_be32(data + 16));
+    info.height = static_cast<int>(read_be32(data + 20));
+
+    std::size_t pos = 8;
+    while (pos + 8 <= size) {
+        const std::uint32_t length = read_be32(data + pos);
+        const unsigned char* type = data + pos + 4;
+        if (std::memcmp(type, "IDAT", 4) == 0 || length > size - pos - 8) break;
+
+        // Pixels per unit in x and y, then the unit: 1 = metre, 0 = aspect only
+        if (std::memcmp(type, "pHYs", 4) == 0 && length >= 9 && data[pos + 16] == 1) {
+            info.dpiX = ppm_to_dpi(read_be32(data + pos + 8));
+            info.dpiY = ppm_to_dpi(read_be32(data + pos + 12));
+        }
+        pos += 12 + static_cast<std::size_t>(length); // length, type, data, CRC
+    }
+    return info.width > 0 && info.height > 0;
+}
+
+// Walks the marker segments up to the first frame header (SOFn), picking
+// up the JFIF density on the way.
+static bool probe_jpeg(const unsigned char* data, std::size_t size, ImageInfo& info) {
+    if (size < 4 || data[0] != 0xFF || data[1] != 0xD8) return false;
+
+    std::size_t pos = 2;
+    while (pos + 4 <= size) {
+        if (data[pos] != 0xFF) return false;
+        const unsigned char marker = data[pos + 1];
+        if (marker == 0xFF) { // fill byte
+            ++pos;
+            continue;
+        }
+        if (marker == 0x01 || (marker >= 0xD0 && marker <= 0xD7)) { // no payload
+            pos += 2;
+            continue;
+        }
+        if (marker == 0xD9 || marker == 0xDA) return false; // EOI/SOS before any frame
+
+        const std::size_t length = read_be16(data + pos + 2);
+        if (length < 2 || pos + 2 + length > size) return false;
+        const unsigned char* segment = data + pos + 4;
+
+        // APP0 "JFIF\0": version (2), units (1), x density (2), y density (2)
+        if (marker == 0xE0 && length >= 14 && std::memcmp(segment, "JFIF", 5) == 0) {
+            const unsigned char units = segment[7];
+            const double perUnit = (units == 1) ? 1.0 : (units == 2) ? 2.54 : 0.0;
+            info.dpiX = read_be16(segment + 8) * perUnit;
+            info.dpiY = read_be16(segment + 10) * perUnit;
+        }
+
+        // SOF0..SOF15 except DHT (C4), JPG (C8) and DAC (CC): precision (1),
+        // height (2), width (2)
+        const bool frame = marker >= 0xC0 && marker <= 0xCF
+            && marker != 0xC4 && marker != 0xC8 && marker != 0xCC;
+        if (frame) {
+            if (length < 7) return false;
+            info.height = static_cast<int>(read_be16(segment + 1));
+            info.width = static_cast<int>(read_be16(segment + 3));
+            return info.width > 0 && info.height > 0;
+        }
+        pos += 2 + length;
+    }
+    return false;
+}
+
+// BITMAPFILEHEADER, then a BITMAPINFOHEADER (or later version).
+static bool probe_bmp(const unsigned char* data, std::size_t size, ImageInfo& info) {
+    if (size < 46 || data[0] != 'B' || data[1] != 'M' || read_le32(data + 14) < 40) {
+        return false;
+    }
+    info.width = static_cast<int>(read_le32(data + 18));
+    // Negative for top-down bitmaps
+    info.height = std::abs(static_cast<int>(read_le32(data + 22)));
+    info.dpiX = ppm_to_dpi(static_cast<int>(read_le32(data + 38)));
+    info.dpiY = ppm_to_dpi(static_cast<int>(read_le32(data + 42)));
+    if (info.dpiX < 0.0 || info.dpiY < 0.0) info.dpiX = info.dpiY = 0.0;
+    return info.width > 0 && info.height > 0;
+}
+
+bool probe_image(const std::string& bytes, ImageInfo& info) {
+    const unsigned char* data = reinterpret_cast<const unsigned char*>(bytes.data());
+    info = ImageInfo();
+    return probe_png(data, bytes.size(), info)
+        || probe_jpeg(data, bytes.size(), info)
+        || probe_bmp(data, bytes.size(), info);
+}
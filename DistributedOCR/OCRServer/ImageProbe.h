@@ -0,0 +1,16 @@
+#pragma once
+
+#include <string>
+
+// What an image's header says about it.
+struct ImageInfo {
+    int width = 0;
+    int height = 0;
+    double dpiX = 0.0; // 0 when the file does not declare a resolution
+    double dpiY = 0.0;
+};
+
+// Reads the dimensions, and the resolution if declared, of a PNG, JPEG or
+// BMP image from its header without decoding any pixels. Returns false for
+// other formats and for headers that are truncated or malformed.
+bool probe_image(const std::string& bytes, ImageInfo& info);
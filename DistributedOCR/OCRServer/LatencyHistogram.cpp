@@ -0,0 +1,79 @@
+#include "LatencyHistogram.h"
+
+#include <algorithm>
+#include <cmath>
+
+std::size_t LatencyHistogram::bucketIndex(std::uint64_t value) {
+    // Values below SUB_BUCKETS get a bucket each
+    if (value < static_cast<std::uint64_t>(SUB_BUCKETS)) return static_cast<std::size_t>(value);
+
+    int exponent = 63;
+    while (!(value >> exponent)) --exponent; // highest set bit
+    if (exponent > MAX_EXPONENT) return BUCKET_COUNT - 1;
+
+    // The SUB_BUCKET_BITS bits below the highest one pick the sub-bucket
+    const std::uint64_t sub = (value >> (exponent - SUB_BUCKET_BITS)) & (SUB_BUCKETS - 1);
+    return static_cast<std::size_t>((exponent - SUB_BUCKET_BITS + 1) * SUB_BUCKETS) + sub;
+}
+
+std::uint64_t LatencyHistogram::bucketUpperBound(std::size_t index) {
+    if (index < static_cast<std::size_t>(SUB_BUCKETS)) return index;
+
+    const int exponent = static_cast<int>(index / SUB_BUCKETS) + SUB_BUCKET_BITS - 1;
+    const std::uint64_t sub = index % SUB_BUCKETS;
+    const std::uint64_t low = (std::uint64_t(1) << exponent)
+        + (sub << (exponent - SUB_BUCKET_BITS));
+    return low + (std::uint64_t(1) << (exponent - SUB_BUCKET_BITS)) - 1;
+}
+
+void LatencyHistogram::record(std::int64_t value) {
+    const std::uint64_t v = value > 0 ? static_cast<std::uint64_t>(value) : 0;
+
+    counts_[bucketIndex(v)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    sum_.fetch_add(v, std::memory_order_relaxed);
+
+    std::uint64_t seen = max_.load(std::memory_order_relaxed);
+    while (v > seen && !max_.compare_exchange_weak(seen, v, std::memory_order_relaxed)) {
+    }
+}
+
+HistogramSnapshot LatencyHistogram::snapshot() const {
+    HistogramSnapshot out;
+    out.counts.resize(BUCKET_COUNT);
+    // Buckets are read one by one while others may be recording, so the
+    // total is taken from them rather than from count_
+    for (std::size_t i = 0; i < BUCKET_COUNT; ++i) {
+        out.counts[i] = counts_[i].load(std::memory_order_relaxed);
+        out.count += out.counts[i];
+    }
+    out.sum = sum_.load(std::memory_order_relaxed);
+    out.max = max_.load(std::memory_order_relaxed);
+    return out;
+}
+
+std::uint64_t HistogramSnapshot::percentile(double q) const {
+    if (count == 0) return 0;
+
+    const std::uint64_t rank = std::max<std::uint64_t>(1,
+        static_cast<std::uint64_t>(std::ceil(std::clamp(q, 0.0, 1.0) * count)));
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < counts.size(); ++i) {
+        seen += counts[i];
+        if (seen >= rank) return std::min(LatencyHistogram::bucketUpperBound(i), max);
+    }
+    return max;
+}
+
+HistogramSnapshot HistogramSnapshot::since(const HistogramSnapshot& earlier) const {
+    HistogramSnapshot out;
+    out.counts.resize(counts.size());
+    for (std::size_t i = 0; i < counts.size(); ++i) {
+        const std::uint64_t before = i < earlier.counts.size() ? earlier.counts[i] : 0;
+        out.counts[i] = counts[i] - before;
+        out.count += out.counts[i];
+        if (out.counts[i] > 0) out.max = std::min(LatencyHistogram::bucketUpperBound(i), max);
+    }
+    out.sum = sum - earlier.sum;
+    return out;
+}
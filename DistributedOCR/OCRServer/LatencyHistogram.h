@@ -0,0 +1,50 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// A point-in-time copy of a LatencyHistogram.
+struct HistogramSnapshot {
+    std::vector<std::uint64_t> counts; // per bucket
+    std::uint64_t count = 0;
+    std::uint64_t sum = 0;
+    std::uint64_t max = 0;
+
+    // Value at quantile q (0..1), as the upper bound of its bucket; 0 when
+    // empty.
+    std::uint64_t percentile(double q) const;
+    double mean() const { return count ? static_cast<double>(sum) / count : 0.0; }
+
+    // What was recorded between earlier (a snapshot of the same histogram)
+    // and this one. max becomes the upper bound of the highest bucket hit.
+    HistogramSnapshot since(const HistogramSnapshot& earlier) const;
+};
+
+// Histogram of non-negative values (latencies in microseconds, sizes in
+// bytes) with log-linear buckets in the style of HdrHistogram: each power of
+// two is split into 16 buckets, so any value is placed within about 6% and
+// the bucket layout is fixed for values up to 2^40. Recording is a few
+// relaxed atomic adds, safe from any number of threads without a lock.
+class LatencyHistogram {
+public:
+    static constexpr int SUB_BUCKET_BITS = 4;
+    static constexpr int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    static constexpr int MAX_EXPONENT = 40;
+    static constexpr std::size_t BUCKET_COUNT = (MAX_EXPONENT - SUB_BUCKET_BITS + 2) * SUB_BUCKETS;
+
+    void record(std::int64_t value);
+    HistogramSnapshot snapshot() const;
+
+    static std::size_t bucketIndex(std::uint64_t value);
+    // Largest value that falls into bucket index.
+    static std::uint64_t bucketUpperBound(std::size_t index);
+
+private:
+    std::array<std::atomic<std::uint64_t>, BUCKET_COUNT> counts_{};
+    std::atomic<std::uint64_t> count_{ 0 };
+    std::atomic<std::uint64_t> sum_{ 0 };
+    std::atomic<std::uint64_t> max_{ 0 };
+};
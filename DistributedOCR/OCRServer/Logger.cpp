@@ -0,0 +1,256 @@
+#include "Logger.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+// Records the ring holds; a power of two.
+static const std::size_t LOG_RING_SIZE = 16384;
+
+// How long the writer sleeps when the ring is empty. Producers never wake
+// it, which is what keeps them lock-free.
+static const auto LOG_IDLE_INTERVAL = std::chrono::milliseconds(20);
+
+static std::atomic<int> log_threshold{ static_cast<int>(LogLevel::Info) };
+
+namespace {
+
+struct LogEntry {
+    LogLevel level = LogLevel::Info;
+    std::chrono::system_clock::time_point time;
+    std::string line;
+};
+
+// Bounded multi-producer queue after Vyukov: each slot carries a sequence
+// number telling producers and the consumer whose turn it is, so a push is
+// one CAS on the head and a pop needs no atomic read-modify-write at all.
+class LogWriter {
+public:
+    LogWriter()
+        : slots_(new Slot[LOG_RING_SIZE]) {
+        for (std::size_t i = 0; i < LOG_RING_SIZE; ++i) {
+            slots_[i].seq.store(i, std::memory_order_relaxed);
+        }
+        thread_ = std::thread(&LogWriter::run, this);
+    }
+
+    ~LogWriter() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        cv_.notify_all();
+        thread_.join();
+    }
+
+    bool push(LogEntry entry) {
+        std::size_t pos = head_.load(std::memory_order_relaxed);
+        while (true) {
+            Slot& slot = slots_[pos & (LOG_RING_SIZE - 1)];
+            const std::size_t seq = slot.seq.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+            if (diff == 0) {
+                if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    slot.entry = std::move(entry);
+                    slot.seq.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (diff < 0) {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return false; // full
+            }
+            else {
+                pos = head_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void flush() {
+        const std::size_t target = head_.load(std::memory_order_acquire);
+        std::unique_lock<std::mutex> lock(mutex_);
+        wantFlush_ = true;
+        cv_.notify_all();
+        flushedCv_.wait(lock, [&] { return written_ >= target || stopping_; });
+    }
+
+    std::uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    struct Slot {
+        std::atomic<std::size_t> seq;
+        LogEntry entry;
+    };
+
+    bool pop(LogEntry& out) {
+        Slot& slot = slots_[tail_ & (LOG_RING_SIZE - 1)];
+        if (slot.seq.load(std::memory_order_acquire) != tail_ + 1) return false;
+        out = std::move(slot.entry);
+        slot.seq.store(tail_ + LOG_RING_SIZE, std::memory_order_release);
+        ++tail_;
+        return true;
+    }
+
+    void run() {
+        std::string out, err;
+        std::uint64_t reportedDrops = 0;
+        LogEntry entry;
+
+        while (true) {
+            while (pop(entry)) {
+                std::string& buffer = entry.level >= LogLevel::Warn ? err : out;
+                format(entry, buffer);
+            }
+            const std::uint64_t drops = dropped();
+            if (drops != reportedDrops) {
+                err += "log: dropped " + std::to_string(drops - reportedDrops)
+                    + " records, ring buffer full\n";
+                reportedDrops = drops;
+            }
+            if (!out.empty()) {
+                std::fwrite(out.data(), 1, out.size(), stdout);
+                std::fflush(stdout);
+                out.clear();
+            }
+            if (!err.empty()) {
+                std::fwrite(err.data(), 1, err.size(), stderr);
+                err.clear();
+            }
+
+            std::unique_lock<std::mutex> lock(mutex_);
+            written_ = tail_;
+            flushedCv_.notify_all();
+            // Anything pushed before stopping_ was set is still drained
+            if (stopping_ && slots_[tail_ & (LOG_RING_SIZE - 1)].seq.load(
+                std::memory_order_acquire) != tail_ + 1) {
+                return;
+            }
+            if (!wantFlush_) {
+                cv_.wait_for(lock, LOG_IDLE_INTERVAL, [this] { return stopping_ || wantFlush_; });
+            }
+            wantFlush_ = false;
+        }
+    }
+
+    static void format(const LogEntry& entry, std::string& buffer) {
+        static const char* const LEVEL_NAMES[] = { "DEBUG", "INFO ", "WARN ", "ERROR" };
+
+        const std::time_t seconds = std::chrono::system_clock::to_time_t(entry.time);
+        const auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(
+            entry.time.time_since_epoch()).count() % 1000;
+        std::tm tm{};
+#ifdef _WIN32
+        localtime_s(&tm, &seconds);
+#else
+        localtime_r(&seconds, &tm);
+#endif
+        char stamp[32];
+        const std::size_t n = std::strftime(stamp, sizeof(stamp), "%Y-%m-%d %H:%M:%S", &tm);
+        std::snprintf(stamp + n, sizeof(stamp) - n, ".%03d ", static_cast<int>(millis));
+
+        buffer += stamp;
+        buffer += LEVEL_NAMES[static_cast<int>(entry.level)];
+        buffer += ' ';
+        buffer += entry.line;
+        buffer += '\n';
+    }
+
+    std::unique_ptr<Slot[]> slots_;
+    alignas(64) std::atomic<std::size_t> head_{ 0 };
+    alignas(64) std::size_t tail_ = 0; // writer thread only
+    std::atomic<std::uint64_t> dropped_{ 0 };
+
+    std::mutex mutex_; // writer sleep and flush only, never taken by push()
+    std::condition_variable cv_;
+    std::condition_variable flushedCv_;
+    bool stopping_ = false;
+    bool wantFlush_ = false;
+    std::size_t written_ = 0;
+
+    std::thread thread_;
+};
+
+} // namespace
+
+static LogWriter& log_writer() {
+    static LogWriter writer;
+    return writer;
+}
+
+void set_log_level(LogLevel level) {
+    log_threshold.store(static_cast<int>(level), std::memory_order_relaxed);
+}
+
+bool log_enabled(LogLevel level) {
+    return static_cast<int>(level) >= log_threshold.load(std::memory_order_relaxed);
+}
+
+bool parse_log_level(const std::string& name, LogLevel& level) {
+    static const std::pair<const char*, LogLevel> NAMES[] = {
+        { "debug", LogLevel::Debug }, { "info", LogLevel::Info },
+        { "warn", LogLevel::Warn }, { "error", LogLevel::Error }, { "off", LogLevel::Off },
+    };
+    for (const auto& entry : NAMES) {
+        if (name == entry.first) {
+            level = entry.second;
+            return true;
+        }
+    }
+    return false;
+}
+
+void flush_log() {
+    log_writer().flush();
+}
+
+std::uint64_t log_dropped() {
+    return log_writer().dropped();
+}
+
+LogRecord::LogRecord(LogLevel level, const char* message)
+    : level_(level), line_(message) {
+}
+
+LogRecord::~LogRecord() {
+    LogEntry entry;
+    entry.level = level_;
+    entry.time = std::chrono::system_clock::now();
+    entry.line = std::move(line_);
+    log_writer().push(std::move(entry));
+}
+
+void LogRecord::appendRaw(const char* key, std::string_view value) {
+    line_ += ' ';
+    line_ += key;
+    line_ += '=';
+    line_ += value;
+}
+
+void LogRecord::appendNumber(const char* key, double value) {
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%g", value);
+    appendRaw(key, buffer);
+}
+
+void LogRecord::appendString(const char* key, std::string_view value) {
+    const bool quote = value.empty()
+        || value.find_first_of(" \t\n\"=") != std::string_view::npos;
+    if (!quote) {
+        appendRaw(key, value);
+        return;
+    }
+
+    std::string quoted = "\"";
+    for (char c : value) {
+        if (c == '"' || c == '\\') quoted += '\\';
+        quoted += (c == '\n') ? ' ' : c;
+    }
+    quoted += '"';
+    appendRaw(key, quoted);
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+// Server logging. A record is formatted on the calling thread into one
+// line of "message key=value ..." and handed to a background writer
+// through a lock-free ring buffer, so logging never blocks a worker on
+// console I/O. When the ring is full, records are dropped and counted
+// rather than waited for.
+//
+//     LOG_DEBUG("processing").kv("worker", workerIndex).kv("id", job->id);
+//
+// Records below the runtime level (Info by default) cost one relaxed load
+// and nothing else; their arguments are not evaluated. Levels below
+// OCR_LOG_MIN_LEVEL are compiled out entirely.
+
+enum class LogLevel { Debug = 0, Info = 1, Warn = 2, Error = 3, Off = 4 };
+
+#ifndef OCR_LOG_MIN_LEVEL
+#define OCR_LOG_MIN_LEVEL 0
+#endif
+
+void set_log_level(LogLevel level);
+bool log_enabled(LogLevel level);
+
+// "debug", "info", "warn", "error" or "off"; false if name is none of them.
+bool parse_log_level(const std::string& name, LogLevel& level);
+
+// Blocks until every record logged so far has been written.
+void flush_log();
+
+// Records dropped because the ring buffer was full.
+std::uint64_t log_dropped();
+
+class LogRecord {
+public:
+    LogRecord(LogLevel level, const char* message);
+    ~LogRecord(); // submits the record
+
+    LogRecord(const LogRecord&) = delete;
+    LogRecord& operator=(const LogRecord&) = delete;
+
+    // Appends key=value. Strings with spaces, quotes or '=' are quoted.
+    template <typename T>
+    LogRecord& kv(const char* key, const T& value) {
+        if constexpr (std::is_same_v<T, bool>) {
+            appendRaw(key, value ? "true" : "false");
+        }
+        else if constexpr (std::is_integral_v<T>) {
+            appendRaw(key, std::to_string(value));
+        }
+        else if constexpr (std::is_floating_point_v<T>) {
+            appendNumber(key, static_cast<double>(value));
+        }
+        else {
+            appendString(key, std::string_view(value));
+        }
+        return *this;
+    }
+
+private:
+    void appendRaw(const char* key, std::string_view value);
+    void appendNumber(const char* key, double value);
+    void appendString(const char* key, std::string_view value);
+
+    LogLevel level_;
+    std::string line_;
+};
+
+#define OCR_LOG(level, message) \
+    if (static_cast<int>(level) < OCR_LOG_MIN_LEVEL || !log_enabled(level)) {} \
+    else LogRecord(level, message)
+
+#define LOG_DEBUG(message) OCR_LOG(LogLevel::Debug, message)
+#define LOG_INFO(message) OCR_LOG(LogLevel::Info, message)
+#define LOG_WARN(message) OCR_LOG(LogLevel::Warn, message)
+#define LOG_ERROR(message) OCR_LOG(LogLevel::Error, message)
@@ -0,0 +1,78 @@
+#include "Metrics.h"
+
+#include <iomanip>
+
+// Upper bounds of the exported latency buckets, in seconds.
+static const double LATENCY_BUCKETS_S[] = {
+    0.0001, 0.00025, 0.0005, 0.001, 0.0025, 0.005, 0.01, 0.025, 0.05,
+    0.1, 0.25, 0.5, 1.0, 2.5, 5.0, 10.0, 30.0, 60.0
+};
+
+std::uint64_t Counter::value() const {
+    std::uint64_t sum = 0;
+    for (const auto& cell : cells_) {
+        sum += cell.value.load(std::memory_order_relaxed);
+    }
+    return sum;
+}
+
+std::size_t Counter::cellIndex() {
+    // Threads are dealt cells round-robin as they first touch any counter
+    static std::atomic<std::size_t> next{ 0 };
+    static thread_local const std::size_t index =
+        next.fetch_add(1, std::memory_order_relaxed) % CELLS;
+    return index;
+}
+
+void PrometheusWriter::header(const std::string& name, const std::string& help,
+    const char* type) {
+    if (!described_.insert(name).second) return;
+    out_ << "# HELP " << name << " " << help << "\n";
+    out_ << "# TYPE " << name << " " << type << "\n";
+}
+
+void PrometheusWriter::sample(const std::string& name, const std::string& labels,
+    double value) {
+    out_ << name;
+    if (!labels.empty()) out_ << "{" << labels << "}";
+    out_ << " " << std::setprecision(12) << value
+        << "\n";
+}
+
+void PrometheusWriter::counter(const std::string& name, const std::string& help,
+    std::uint64_t value, const std::string& labels) {
+    header(name, help, "counter");
+    out_ << name;
+    if (!labels.empty()) out_ << "{" << labels << "}";
+    out_ << " " << value << "\n";
+}
+
+void PrometheusWriter::gauge(const std::string& name, const std::string& help,
+    double value, const std::string& labels) {
+    header(name, help, "gauge");
+    sample(name, labels, value);
+}
+
+void PrometheusWriter::latencyHistogram(const std::string& name, const std::string& help,
+    const HistogramSnapshot& snapshot, const std::string& labels) {
+    header(name, help, "histogram");
+
+    const std::string prefix = labels.empty() ? std::string() : labels + ",";
+    std::size_t bucket = 0;
+    std::uint64_t cumulative = 0;
+    for (double bound : LATENCY_BUCKETS_S) {
+        const double boundUs = bound * 1e6;
+        while (bucket < snapshot.counts.size()
+            && static_cast<double>(LatencyHistogram::bucketUpperBound(bucket)) <= boundUs) {
+            cumulative += snapshot.counts[bucket++];
+        }
+        std::ostringstream le;
+        le << prefix << "le=\"" << bound << "\"";
+        out_ << name << "_bucket{" << le.str() << "} " << cumulative << "\n";
+    }
+    out_ << name << "_bucket{" << prefix << "le=\"+Inf\"} " << snapshot.count << "\n";
+    sample(name + "_sum", labels, static_cast<double>(snapshot.sum) / 1e6);
+    out_ << name << "_count";
+    if (!labels.empty()) out_ << "{" << labels << "}";
+    out_ << " " << snapshot.count << "\n";
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "LatencyHistogram.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <sstream>
+#include <string>
+
+// Monotonic counter that many threads bump at once. Each thread adds to one
+// of a few cache-line-sized cells, picked once per thread, so hot counters
+// do not bounce a single line between cores; value() sums the cells.
+class Counter {
+public:
+    void add(std::uint64_t n = 1) {
+        cells_[cellIndex()].value.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    std::uint64_t value() const;
+
+private:
+    static constexpr std::size_t CELLS = 16;
+
+    struct alignas(64) Cell {
+        std::atomic<std::uint64_t> value{ 0 };
+    };
+
+    static std::size_t cellIndex();
+
+    std::array<Cell, CELLS> cells_;
+};
+
+// Builds a scrape in the Prometheus text exposition format (0.0.4). Call
+// the methods for one metric family together; # HELP and # TYPE are
+// written before its first sample. labels is either empty or the inside
+// of the braces, e.g. priority="bulk".
+class PrometheusWriter {
+public:
+    void counter(const std::string& name, const std::string& help,
+        std::uint64_t value, const std::string& labels = std::string());
+    void gauge(const std::string& name, const std::string& help,
+        double value, const std::string& labels = std::string());
+
+    // A histogram of microsecond samples, exported in seconds with fixed
+    // buckets from 100us to 60s. Bucket counts are rounded to the
+    // histogram's own resolution (within about 6%).
+    void latencyHistogram(const std::string& name, const std::string& help,
+        const HistogramSnapshot& snapshot, const std::string& labels = std::string());
+
+    std::string str() const { return out_.str(); }
+
+private:
+    void header(const std::string& name, const std::string& help, const char* type);
+    void sample(const std::string& name, const std::string& labels, double value);
+
+    std::ostringstream out_;
+    std::set<std::string> described_;
+};
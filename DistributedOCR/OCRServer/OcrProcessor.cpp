@@ -1,71 +1,236 @@
 #include "OcrProcessor.h"
+#include "CancellationToken.h"
+#include "ImageProbe.h"
+#include "Logger.h"
+#include "Preprocess.h"
+#include "TessEnginePool.h"
 
 #include <opencv2/opencv.hpp>
 #include <tesseract/baseapi.h>
+#include <tesseract/ocrclass.h>
 #include <leptonica/allheaders.h>
 
 #include <vector>
+#include <algorithm>
 #include <chrono>
+#include <filesystem>
+#include <set>
 #include <stdexcept>
 #include <memory>
-#include <iostream>
+#include <mutex>
+#include <thread>
 
-// Thread-local Tesseract instance - initialized once per thread
-thread_local std::unique_ptr<tesseract::TessBaseAPI> tess_instance;
+// CHANGE TESSERACT FILE PATH HERE (where eng.traineddata is), or pass
+// --tessdata to the server
+static std::string tessdata_dir = "C:/Users/Rain/AppData/Local/Programs/Tesseract-OCR/tessdata";
 
-tesseract::TessBaseAPI* get_tess_instance() {
-    if (!tess_instance) {
-        std::cout << "[Thread " << std::this_thread::get_id()
-            << "] Initializing Tesseract...\n";
+// Decode limits; see configure_decode(). Set at startup, before any OCR.
+static std::size_t decode_max_pixels = 16 * 1000 * 1000;
+static int decode_target_dpi = 300;
 
-        tess_instance = std::make_unique<tesseract::TessBaseAPI>();
+void configure_decode(std::size_t maxPixels, int targetDpi) {
+    decode_max_pixels = maxPixels;
+    decode_target_dpi = targetDpi;
+}
+
+// See configure_preprocessing(). Set at startup, before any OCR.
+static PreprocessOptions preprocess_options;
+
+void configure_preprocessing(const PreprocessOptions& options) {
+    preprocess_options = options;
+}
+
+std::string ocr_config_key(const OcrSettings& settings) {
+    // Decoding and preprocessing change what Tesseract sees, so they are
+    // part of it
+    const PreprocessOptions& pre = preprocess_options;
+    std::string stages;
+    if (pre.denoise) stages += "median3,";
+    if (pre.binarize) {
+        stages += "sauvola" + std::to_string(pre.sauvolaWindow)
+            + "/" + std::to_string(pre.sauvolaK) + ",";
+        if (pre.deskew) stages += "deskew" + std::to_string(pre.maxSkewDegrees) + ",";
+        if (pre.cropBorders) stages += "crop,";
+    }
+
+    return "lang=" + settings.language
+        + ";oem=" + std::to_string(settings.engineMode)
+        + ";psm=" + std::to_string(settings.pageSegMode)
+        + ";maxpx=" + std::to_string(decode_max_pixels)
+        + ";dpi=" + std::to_string(decode_target_dpi)
+        + ";pre=" + stages;
+}
+
+static std::mutex tess_engines_mutex;
+static std::unique_ptr<TessEngineRegistry> tess_engines_registry;
+
+// Languages with a <name>.traineddata in tessdata_dir, read on first use
+// and again after init_tess_engines(). Guarded by tess_engines_mutex.
+static std::set<std::string> installed_languages;
+static bool installed_languages_read = false;
+
+static bool language_installed(const std::string& name) {
+    std::lock_guard<std::mutex> lock(tess_engines_mutex);
+    if (!installed_languages_read) {
+        installed_languages.clear();
+        std::error_code ec;
+        for (std::filesystem::directory_iterator it(tessdata_dir, ec), end; !ec && it != end;
+            it.increment(ec)) {
+            const std::filesystem::path& path = it->path();
+            if (path.extension() == ".traineddata") {
+                installed_languages.insert(path.stem().string());
+            }
+        }
+        installed_languages_read = true;
+        LOG_INFO("tessdata languages").kv("dir", tessdata_dir)
+            .kv("count", installed_languages.size());
+    }
+    return installed_languages.count(name) > 0;
+}
 
-        // CHANGE TESSERACT FILE PATH HERE (where eng.traineddata is)
-        if (tess_instance->Init("C:/Users/Rain/AppData/Local/Programs/Tesseract-OCR/tessdata", "eng") != 0) {
-            tess_instance.reset();
-            throw std::runtime_error("Could not initialize Tesseract");
+// Language sets come from requests and are passed to Tesseract as file
+// names, so only installed languages joined by '+', each at most once, are
+// accepted.
+static void check_language(const std::string& language) {
+    bool valid = !language.empty() && language.front() != '+' && language.back() != '+';
+    for (char c : language) {
+        const bool plain = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z')
+            || (c >= '0' && c <= '9') || c == '_' || c == '+';
+        valid = valid && plain;
+    }
+    if (!valid) {
+        throw std::invalid_argument("Invalid OCR language '" + language + "'");
+    }
+
+    std::set<std::string> seen;
+    std::size_t start = 0;
+    while (start <= language.size()) {
+        const std::size_t end = std::min(language.find('+', start), language.size());
+        const std::string name = language.substr(start, end - start);
+        if (name.empty() || !seen.insert(name).second) {
+            throw std::invalid_argument("Invalid OCR language '" + language + "'");
+        }
+        if (!language_installed(name)) {
+            throw std::invalid_argument("OCR language '" + name + "' is not installed");
         }
+        start = end + 1;
+    }
+}
+
+static std::unique_ptr<tesseract::TessBaseAPI> create_tess_engine(const std::string& language,
+    int engineMode) {
+    auto engine = std::make_unique<tesseract::TessBaseAPI>();
 
-        std::cout << "[Thread " << std::this_thread::get_id()
-            << "] Tesseract initialized successfully\n";
+    if (engine->Init(tessdata_dir.c_str(), language.c_str(),
+        static_cast<tesseract::OcrEngineMode>(engineMode)) != 0) {
+        throw ModelLoadError("Could not initialize Tesseract for language '" + language
+            + "', engine mode " + std::to_string(engineMode));
     }
-    return tess_instance.get();
+    return engine;
 }
 
-OcrResult run_ocr_on_bytes(const std::string& imageBytes)
-{
-    std::cout << "[OCR] Processing image (" << imageBytes.size() << " bytes)\n";
+void init_tess_engines(const std::string& tessdataDir, std::size_t maxEnginesPerModel,
+    std::size_t warmEngines, const std::vector<std::string>& languages,
+    std::size_t maxEngines) {
+    TessEngineRegistry* registry = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(tess_engines_mutex);
+        if (!tessdataDir.empty()) tessdata_dir = tessdataDir;
+        installed_languages_read = false;
+        if (!tess_engines_registry) {
+            tess_engines_registry = std::make_unique<TessEngineRegistry>(
+                maxEnginesPerModel, maxEngines, &create_tess_engine);
+        }
+        registry = tess_engines_registry.get();
+    }
 
-    // 1) Decode bytes into cv::Mat
-    std::vector<uchar> buffer(imageBytes.begin(), imageBytes.end());
-    cv::Mat img = cv::imdecode(buffer, cv::IMREAD_COLOR);
-    if (img.empty()) {
-        throw std::runtime_error("Failed to decode image data");
+    const OcrSettings defaults;
+    for (const auto& language : languages) {
+        check_language(language);
+        registry->warmUp(language, defaults.engineMode, warmEngines);
+    }
+}
+
+static TessEngineRegistry& tess_engines() {
+    std::lock_guard<std::mutex> lock(tess_engines_mutex);
+    if (!tess_engines_registry) {
+        // Not configured: grow on demand, one engine per hardware thread
+        tess_engines_registry = std::make_unique<TessEngineRegistry>(
+            std::thread::hardware_concurrency(), 0, &create_tess_engine);
     }
+    return *tess_engines_registry;
+}
 
-    std::cout << "[OCR] Decoded image: " << img.cols << "x" << img.rows << "\n";
+std::size_t trim_tess_engines(std::size_t keepPerModel) {
+    return tess_engines().trim(keepPerModel);
+}
 
-    // 2) Convert to grayscale
-    cv::Mat gray;
-    cv::cvtColor(img, gray, cv::COLOR_BGR2GRAY);
+// An engine for settings' model, set to its page segmentation mode.
+static TessEnginePool::Lease checkout_engine(const OcrSettings& settings,
+    const CancellationToken* cancel) {
+    check_language(settings.language);
+    TessEnginePool::Lease tess = tess_engines()
+        .pool(settings.language, settings.engineMode).checkout(cancel);
+    tess->SetPageSegMode(static_cast<tesseract::PageSegMode>(settings.pageSegMode));
+    return tess;
+}
 
-    std::cout << "[OCR] Converted to grayscale\n";
+static long long elapsed_us(std::chrono::steady_clock::time_point from,
+    std::chrono::steady_clock::time_point to) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(to - from).count();
+}
 
-    // 3) Get thread-local Tesseract instance
-    tesseract::TessBaseAPI* tess = get_tess_instance();
+// Tesseract's cancel hook: polled between words during Recognize().
+static bool tess_cancel_requested(void* cancelThis, int /*words*/) {
+    return static_cast<const CancellationToken*>(cancelThis)->isCancelled();
+}
 
-    std::cout << "[OCR] Got Tesseract instance, setting image...\n";
+static void throw_if_cancelled(const CancellationToken* cancel) {
+    if (cancel && cancel->isCancelled()) {
+        throw OcrCancelledError("OCR cancelled");
+    }
+}
 
-    // 4) Run OCR with timing
-    auto start = std::chrono::high_resolution_clock::now();
+// Runs recognition on an 8-bit image (or region view) with a pooled
+// Tesseract engine. A binary (0/255) page is handed over packed to 1 bit
+// per pixel, so Tesseract skips its own thresholding. The pixels are only
+// read.
+// Adds the engine wait and recognition time to timings.
+static std::string recognize_page(const cv::Mat& page, bool binary,
+    const OcrSettings& settings, const CancellationToken* cancel, OcrTimings& timings) {
+    // Packed before an engine is taken, so engines are not held idle
+    const cv::Mat packed = binary ? pack_binary(page) : cv::Mat();
 
-    tess->SetImage(gray.data,
-        gray.cols,
-        gray.rows,
-        1,                        // bytes per pixel
-        static_cast<int>(gray.step));
+    const auto waitStart = std::chrono::steady_clock::now();
+    TessEnginePool::Lease tess = checkout_engine(settings, cancel);
+    const auto start = std::chrono::steady_clock::now();
+    timings.engineWaitUs += elapsed_us(waitStart, start);
+    if (binary) {
+        tess->SetImage(packed.data,
+            page.cols,
+            page.rows,
+            0,                        // bytes per pixel: 0 means 1 bit
+            static_cast<int>(packed.step));
+    }
+    else {
+        tess->SetImage(page.data,
+            page.cols,
+            page.rows,
+            1,                        // bytes per pixel
+            static_cast<int>(page.step));
+    }
 
-    std::cout << "[OCR] Running recognition...\n";
+    // Recognize explicitly so Tesseract can abort early when cancelled
+    tesseract::ETEXT_DESC monitor;
+    if (cancel) {
+        monitor.cancel = &tess_cancel_requested;
+        monitor.cancel_this = const_cast<CancellationToken*>(cancel);
+    }
+    if (tess->Recognize(&monitor) != 0) {
+        throw_if_cancelled(cancel);
+        throw std::runtime_error("Tesseract recognition failed");
+    }
+    throw_if_cancelled(cancel);
 
     char* outText = tess->GetUTF8Text();
     std::string text = outText ? std::string(outText) : "";
@@ -73,13 +238,286 @@ OcrResult run_ocr_on_bytes(const std::string& imageBytes)
     if (outText) {
         delete[] outText;
     }
+    timings.recognitionUs += elapsed_us(start, std::chrono::steady_clock::now());
+    return text;
+}
+
+// How far to scale an image down on decode (1, 2, 4 or 8) to bring it
+// within the pixel budget and to no more than twice the target resolution.
+static int decode_reduction(double pixels, double dpi) {
+    const double maxPixels = static_cast<double>(decode_max_pixels);
+    int factor = 1;
+    while (factor < 8 && maxPixels > 0.0 && pixels / (factor * factor) > maxPixels) {
+        factor *= 2;
+    }
+    while (factor < 8 && decode_target_dpi > 0 && dpi / (factor * 2) >= decode_target_dpi) {
+        factor *= 2;
+    }
+    return factor;
+}
+
+// Decodes straight to 8-bit grayscale, never to a BGR buffer. Images over
+// the limits set by configure_decode() are reduced while decoding where the
+// header tells us the size up front (JPEG then only runs the DCT at the
+// reduced scale), and resized afterwards otherwise.
+static cv::Mat decode_gray(const std::string& imageBytes) {
+    // The header wraps the caller's buffer directly; imdecode only reads
+    // from it.
+    cv::Mat encoded(1, static_cast<int>(imageBytes.size()), CV_8UC1,
+        const_cast<char*>(imageBytes.data()));
+
+    int factor = 1;
+    ImageInfo info;
+    if (probe_image(imageBytes, info)) {
+        factor = decode_reduction(static_cast<double>(info.width) * info.height,
+            std::max(info.dpiX, info.dpiY));
+    }
+
+    const int flags = (factor == 8) ? cv::IMREAD_REDUCED_GRAYSCALE_8
+        : (factor == 4) ? cv::IMREAD_REDUCED_GRAYSCALE_4
+        : (factor == 2) ? cv::IMREAD_REDUCED_GRAYSCALE_2
+        : cv::IMREAD_GRAYSCALE;
+    cv::Mat gray = cv::imdecode(encoded, flags);
+    if (gray.empty()) {
+        throw std::runtime_error("Failed to decode image data");
+    }
 
-    auto end = std::chrono::high_resolution_clock::now();
-    long long ms =
-        std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+    if (factor > 1) {
+        LOG_DEBUG("decoded reduced").kv("width", info.width).kv("height", info.height)
+            .kv("scale", factor);
+        return gray;
+    }
 
-    std::cout << "[OCR] Recognition complete in " << ms << "ms, extracted "
-        << text.length() << " characters\n";
+    // Format we cannot probe: enforce the pixel budget after the fact
+    const double pixels = static_cast<double>(gray.cols) * gray.rows;
+    const int late = decode_reduction(pixels, 0.0);
+    if (late > 1) {
+        cv::Mat reduced;
+        cv::resize(gray, reduced, cv::Size(gray.cols / late, gray.rows / late), 0, 0,
+            cv::INTER_AREA);
+        gray = reduced;
+    }
+    return gray;
+}
 
-    return { text, ms };
-}
\ No newline at end of file
+// Decodes the image and runs the configured preprocessing on it, filling
+// in the decode and preprocess times.
+static cv::Mat prepare_page(const std::string& imageBytes, OcrTimings& timings) {
+    const auto start = std::chrono::steady_clock::now();
+    cv::Mat gray = decode_gray(imageBytes);
+    const auto decoded = std::chrono::steady_clock::now();
+    timings.decodeUs = elapsed_us(start, decoded);
+    LOG_DEBUG("decoded").kv("width", gray.cols).kv("height", gray.rows)
+        .kv("us", timings.decodeUs);
+
+    std::vector<StageTiming> stages;
+    cv::Mat page = preprocess_page(gray, preprocess_options, &stages);
+    timings.preprocessUs = elapsed_us(decoded, std::chrono::steady_clock::now());
+    if (!stages.empty() && log_enabled(LogLevel::Debug)) {
+        LogRecord record(LogLevel::Debug, "preprocessed");
+        for (const auto& t : stages) record.kv(t.stage.c_str(), t.micros);
+        record.kv("width", page.cols).kv("height", page.rows);
+    }
+    return page;
+}
+
+OcrResult run_ocr_on_bytes(const std::string& imageBytes,
+    const CancellationToken* cancel, const OcrSettings& settings)
+{
+    OcrResult result{};
+
+    // 1) Decode bytes to grayscale and clean up
+    cv::Mat page = prepare_page(imageBytes, result.timings);
+
+    throw_if_cancelled(cancel);
+
+    // 2) Run OCR with timing
+    result.text = recognize_page(page, preprocess_options.binarize, settings, cancel,
+        result.timings);
+    result.processingTimeMs = result.timings.recognitionUs / 1000;
+
+    LOG_DEBUG("recognized").kv("bytes", imageBytes.size())
+        .kv("ms", result.processingTimeMs).kv("chars", result.text.length());
+
+    return result;
+}
+
+struct TiledPage::Impl {
+    OcrSettings settings;
+    cv::Mat gray;   // preprocessed; binary if binary is set
+    bool binary = false;
+    std::vector<cv::Rect> regions; // reading order
+    OcrTimings timings;
+};
+
+// Squared distance between the nearest edges of two rectangles; 0 if they
+// touch or overlap.
+static long long rect_gap2(const cv::Rect& a, const cv::Rect& b) {
+    const long long dx = std::max({ 0, b.x - (a.x + a.width), a.x - (b.x + b.width) });
+    const long long dy = std::max({ 0, b.y - (a.y + a.height), a.y - (b.y + b.height) });
+    return dx * dx + dy * dy;
+}
+
+// Regions found by Tesseract's layout analysis, in its reading order.
+static std::vector<cv::Rect> layout_blocks(const cv::Mat& gray, const OcrSettings& settings,
+    const CancellationToken* cancel) {
+    // Blocks smaller than this (a page number, a lone character) are not
+    // worth a job of their own and are folded into the nearest block
+    const int MIN_BLOCK_PIXELS = 32 * 32;
+
+    TessEnginePool::Lease tess = checkout_engine(settings, cancel);
+    tess->SetImage(gray.data, gray.cols, gray.rows, 1, static_cast<int>(gray.step));
+
+    // Layout only; the regions are then read with the requested mode
+    tess->SetPageSegMode(tesseract::PSM_AUTO_ONLY);
+    std::unique_ptr<tesseract::PageIterator> it(tess->AnalyseLayout());
+
+    std::vector<cv::Rect> blocks;
+    if (!it) return blocks;
+
+    it->Begin();
+    do {
+        int left = 0, top = 0, right = 0, bottom = 0;
+        if (!it->BoundingBox(tesseract::RIL_BLOCK, &left, &top, &right, &bottom)) continue;
+        blocks.emplace_back(left, top, right - left, bottom - top);
+    } while (it->Next(tesseract::RIL_BLOCK));
+
+    std::vector<bool> merged(blocks.size(), false);
+    for (std::size_t i = 0; i < blocks.size(); ++i) {
+        if (blocks[i].area() >= MIN_BLOCK_PIXELS) continue;
+
+        std::size_t nearest = blocks.size();
+        for (std::size_t j = 0; j < blocks.size(); ++j) {
+            if (merged[j] || blocks[j].area() < MIN_BLOCK_PIXELS) continue;
+            if (nearest == blocks.size()
+                || rect_gap2(blocks[i], blocks[j]) < rect_gap2(blocks[i], blocks[nearest])) {
+                nearest = j;
+            }
+        }
+        if (nearest == blocks.size()) continue; // nothing bigger on the page
+
+        // Growing the block over another one would read that text twice;
+        // the small block then stays a region of its own
+        const cv::Rect grown = blocks[nearest] | blocks[i];
+        bool overlaps = false;
+        for (std::size_t j = 0; j < blocks.size() && !overlaps; ++j) {
+            overlaps = j != nearest && j != i && !merged[j] && (grown & blocks[j]).area() > 0;
+        }
+        if (overlaps) continue;
+
+        blocks[nearest] = grown;
+        merged[i] = true;
+    }
+
+    std::vector<cv::Rect> kept;
+    for (std::size_t i = 0; i < blocks.size(); ++i) {
+        if (!merged[i]) kept.push_back(blocks[i]);
+    }
+    return kept;
+}
+
+// Splits the page into count horizontal bands, moving each cut to the
+// lightest row near it so text lines are not sliced in half. Short pages
+// get fewer bands, none of them empty.
+static std::vector<cv::Rect> horizontal_bands(const cv::Mat& gray, std::size_t count) {
+    // A couple of text lines at 300 dpi; thinner bands cut through glyphs
+    const int MIN_BAND_ROWS = 64;
+
+    count = std::clamp<std::size_t>(count, 1,
+        std::max(1, gray.rows / MIN_BAND_ROWS));
+    if (count == 1) return { cv::Rect(0, 0, gray.cols, gray.rows) };
+
+    cv::Mat rowSums;
+    cv::reduce(gray, rowSums, 1, cv::REDUCE_SUM, CV_32S);
+
+    const int bandHeight = gray.rows / static_cast<int>(count);
+    const int slack = bandHeight / 4;
+
+    std::vector<cv::Rect> bands;
+    int top = 0;
+    for (std::size_t i = 1; i < count; ++i) {
+        const int nominal = static_cast<int>(i) * bandHeight;
+
+        int cut = nominal;
+        const int first = std::max(top + 1, nominal - slack);
+        const int last = std::min(gray.rows - 1, nominal + slack);
+        for (int row = first; row <= last; ++row) {
+            if (rowSums.at<int>(row, 0) > rowSums.at<int>(cut, 0)) cut = row;
+        }
+
+        if (cut <= top) continue;
+        bands.emplace_back(0, top, gray.cols, cut - top);
+        top = cut;
+    }
+    if (top < gray.rows) bands.emplace_back(0, top, gray.cols, gray.rows - top);
+    return bands;
+}
+
+std::shared_ptr<TiledPage> TiledPage::analyse(const std::string& imageBytes,
+    const OcrSettings& settings, std::size_t minPixels, std::size_t maxRegions,
+    const CancellationToken* cancel) {
+    auto page = std::shared_ptr<TiledPage>(new TiledPage());
+    page->impl_ = std::make_shared<Impl>();
+
+    Impl& impl = *page->impl_;
+    impl.settings = settings;
+    impl.gray = prepare_page(imageBytes, impl.timings);
+    impl.binary = preprocess_options.binarize;
+    throw_if_cancelled(cancel);
+
+    const cv::Rect whole(0, 0, impl.gray.cols, impl.gray.rows);
+    const std::size_t pixels = static_cast<std::size_t>(impl.gray.cols) * impl.gray.rows;
+    if (pixels < minPixels || maxRegions < 2) {
+        impl.regions.push_back(whole);
+        return page;
+    }
+
+    const auto layoutStart = std::chrono::steady_clock::now();
+    impl.regions = layout_blocks(impl.gray, settings, cancel);
+    if (impl.regions.size() < 2 || impl.regions.size() > maxRegions) {
+        // One big block (a dense page) or too many tiny ones: cut the page
+        // into bands instead, a few per worker's worth of work.
+        const std::size_t bandCount = std::min<std::size_t>(maxRegions,
+            std::max<std::size_t>(2, pixels / minPixels * 2));
+        impl.regions = horizontal_bands(impl.gray, bandCount);
+    }
+    impl.timings.layoutUs = elapsed_us(layoutStart, std::chrono::steady_clock::now());
+
+    LOG_DEBUG("page split").kv("width", impl.gray.cols).kv("height", impl.gray.rows)
+        .kv("regions", impl.regions.size());
+    return page;
+}
+
+std::size_t TiledPage::regionCount() const {
+    return impl_->regions.size();
+}
+
+std::string TiledPage::recognizeRegion(std::size_t index, const CancellationToken* cancel,
+    OcrTimings* timings) const {
+    throw_if_cancelled(cancel);
+
+    // A view into the shared page; nothing is copied
+    const cv::Mat region = impl_->gray(impl_->regions.at(index));
+    OcrTimings regionTimings;
+    std::string text = recognize_page(region, impl_->binary, impl_->settings, cancel,
+        regionTimings);
+    if (timings) {
+        timings->engineWaitUs += regionTimings.engineWaitUs;
+        timings->recognitionUs += regionTimings.recognitionUs;
+    }
+    return text;
+}
+
+const OcrTimings& TiledPage::timings() const {
+    return impl_->timings;
+}
+
+std::string TiledPage::stitch(const std::vector<std::string>& texts) {
+    std::string out;
+    for (const auto& text : texts) {
+        if (text.empty()) continue;
+        out += text;
+        if (out.back() != '\n') out += '\n';
+    }
+    return out;
+}
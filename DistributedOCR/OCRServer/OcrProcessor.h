@@ -1,11 +1,123 @@
 #pragma once
 
+#include <cstddef>
+#include <memory>
 #include <string>
 #include <thread>
+#include <vector>
+
+class CancellationToken;
+
+// Where an image's time went, in microseconds. Stages an image did not go
+// through (a cache hit, an untiled page's layout) stay 0.
+struct OcrTimings {
+    long long queueWaitUs = 0;   // enqueued to picked up by a worker
+    long long decodeUs = 0;
+    long long preprocessUs = 0;
+    long long layoutUs = 0;      // tiled pages: layout analysis
+    long long engineWaitUs = 0;  // waiting for a free Tesseract engine
+    long long recognitionUs = 0; // summed over regions for tiled pages
+    long long totalUs = 0;       // received to result ready
+};
 
 struct OcrResult {
     std::string text;
     long long processingTimeMs;
+    OcrTimings timings;
 };
 
-OcrResult run_ocr_on_bytes(const std::string& imageBytes);
+// Recognition settings for one image. Engines are loaded per model
+// (language set and engine mode); the page segmentation mode is switched
+// per image.
+struct OcrSettings {
+    std::string language = "eng"; // Tesseract language set, e.g. "eng+deu"
+    int engineMode = 3;           // tesseract::OcrEngineMode; 3 = OEM_DEFAULT
+    int pageSegMode = 6;          // tesseract::PageSegMode; 6 = PSM_SINGLE_BLOCK
+};
+
+// Time spent in one stage of processing an image.
+struct StageTiming {
+    std::string stage;
+    long long micros;
+};
+
+// Image cleanup run between decoding and recognition (see Preprocess.h).
+// All stages are off by default; binarized pages are handed to Tesseract
+// as 1 bit per pixel, which skips its own thresholding.
+struct PreprocessOptions {
+    bool denoise = false;
+    bool binarize = false;
+    int sauvolaWindow = 31;     // pixels; odd
+    double sauvolaK = 0.34;
+    bool deskew = false;        // needs binarize
+    double maxSkewDegrees = 10.0;
+    bool cropBorders = false;   // needs binarize
+};
+
+// Sets the preprocessing every image gets. Call at startup, before any OCR.
+void configure_preprocessing(const PreprocessOptions& options);
+
+// If cancel is given, the job is abandoned (OcrCancelledError) as soon as it
+// is cancelled, including mid-recognition. Throws std::invalid_argument for
+// a malformed language and std::runtime_error if its model cannot be loaded.
+OcrResult run_ocr_on_bytes(const std::string& imageBytes,
+    const CancellationToken* cancel = nullptr,
+    const OcrSettings& settings = OcrSettings());
+
+// Sets up the Tesseract engines OCR runs on, shared by all threads. Each
+// model gets at most maxEnginesPerModel engines, and all models together
+// at most maxEngines (0: twice maxEnginesPerModel); idle engines of the
+// least recently used models make way for new ones. warmEngines are
+// loaded now, for each of languages (in the default engine mode), rather
+// than on first use. Other models are loaded when first asked for. Call
+// once at startup; without it, engines are created as needed from the
+// built-in tessdata path, up to one per hardware thread and model.
+void init_tess_engines(const std::string& tessdataDir, std::size_t maxEnginesPerModel,
+    std::size_t warmEngines, const std::vector<std::string>& languages,
+    std::size_t maxEngines = 0);
+
+// Frees idle engines beyond keepPerModel for each model, e.g. after the
+// worker pool has shrunk; more are loaded again on demand. Returns how many
+// were freed.
+std::size_t trim_tess_engines(std::size_t keepPerModel);
+
+// Images are decoded straight to grayscale, and scaled down by 2, 4 or 8
+// while decoding when they exceed maxPixels or declare a resolution of at
+// least twice targetDpi. 0 disables either limit. Defaults: 16 megapixels,
+// 300 dpi. Call at startup, before any OCR.
+void configure_decode(std::size_t maxPixels, int targetDpi);
+
+// Identifies recognition settings; cached results are keyed by it.
+std::string ocr_config_key(const OcrSettings& settings = OcrSettings());
+
+// A decoded page split into regions that can be recognized independently,
+// so one large image can be spread over several threads. Regions are
+// Tesseract's layout blocks, or horizontal bands cut at blank rows when
+// layout analysis finds a single block (or a confetti of tiny ones), and
+// come in reading order. recognizeRegion() may be called concurrently;
+// each call checks out its own Tesseract engine.
+class TiledPage {
+public:
+    // Decodes the image. Pages of at least minPixels are split into at
+    // most maxRegions regions; smaller ones get a single region.
+    static std::shared_ptr<TiledPage> analyse(const std::string& imageBytes,
+        const OcrSettings& settings, std::size_t minPixels, std::size_t maxRegions,
+        const CancellationToken* cancel = nullptr);
+
+    std::size_t regionCount() const;
+    // Adds the region's engine wait and recognition time to timings.
+    std::string recognizeRegion(std::size_t index,
+        const CancellationToken* cancel = nullptr, OcrTimings* timings = nullptr) const;
+
+    // Decode, preprocess and layout time spent by analyse().
+    const OcrTimings& timings() const;
+
+    // Joins region texts, in region order, into the page's text.
+    static std::string stitch(const std::vector<std::string>& texts);
+
+private:
+    TiledPage() = default;
+
+    struct Impl;
+    std::shared_ptr<Impl> impl_;
+};
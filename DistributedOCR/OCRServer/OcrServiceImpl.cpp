@@ -0,0 +1,679 @@
+#include "OcrServiceImpl.h"
+#include "CancellationToken.h"
+#include "Logger.h"
+#include "Metrics.h"
+#include "ResultChannel.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+using grpc::ServerContext;
+using grpc::ServerReaderWriter;
+using grpc::ServerWriter;
+using grpc::Status;
+
+using ocr::BatchRequest;
+using ocr::BatchResponse;
+using ocr::BatchResult;
+using ocr::ImageChunk;
+using ocr::ImageTask;
+using ocr::StageTimings;
+using ocr::StatsRequest;
+using ocr::StatsResponse;
+
+CancellationToken::Clock::time_point job_deadline(const ServerContext& context) {
+    // Used only when the client sends no deadline of its own
+    const auto DEFAULT_CALL_BUDGET = std::chrono::seconds(120);
+
+    const auto clientDeadline = context.deadline();
+    if (clientDeadline == std::chrono::system_clock::time_point::max()) {
+        return CancellationToken::Clock::now() + DEFAULT_CALL_BUDGET;
+    }
+
+    // gRPC reports the deadline on the system clock; the pool runs on the
+    // steady clock.
+    return CancellationToken::Clock::now()
+        + std::chrono::duration_cast<CancellationToken::Clock::duration>(
+            clientDeadline - std::chrono::system_clock::now());
+}
+
+// Value of a client metadata entry, or "" if it was not sent.
+static std::string client_metadata(const ServerContext& context, const std::string& key) {
+    const auto& metadata = context.client_metadata();
+    auto it = metadata.find(key);
+    if (it == metadata.end()) return std::string();
+    return std::string(it->second.data(), it->second.size());
+}
+
+JobClass job_class(const ServerContext& context, const BatchRequest* request) {
+    JobClass jobClass;
+
+    if (request && request->priority() != ocr::PRIORITY_NORMAL) {
+        jobClass.priority = (request->priority() == ocr::PRIORITY_INTERACTIVE)
+            ? JobPriority::Interactive
+            : JobPriority::Bulk;
+    }
+    else {
+        const std::string priority = client_metadata(context, "ocr-priority");
+        if (priority == "interactive") jobClass.priority = JobPriority::Interactive;
+        if (priority == "bulk") jobClass.priority = JobPriority::Bulk;
+    }
+
+    jobClass.client = (request && !request->client_id().empty())
+        ? request->client_id()
+        : client_metadata(context, "ocr-client-id");
+    if (jobClass.client.empty()) {
+        // "ipv4:10.0.0.5:51234" -> "ipv4:10.0.0.5"; the port changes with
+        // every connection, the host does not
+        jobClass.client = context.peer();
+        const auto colon = jobClass.client.rfind(':');
+        if (colon != std::string::npos && colon > jobClass.client.find(':')) {
+            jobClass.client.erase(colon);
+        }
+    }
+    return jobClass;
+}
+
+static OcrSettings make_settings(const std::string& language, ocr::EngineMode engineMode,
+    ocr::PageLayout layout) {
+    OcrSettings settings;
+    if (!language.empty()) settings.language = language;
+
+    // Values of tesseract::OcrEngineMode and tesseract::PageSegMode
+    switch (engineMode) {
+    case ocr::ENGINE_LSTM: settings.engineMode = 1; break;
+    case ocr::ENGINE_LEGACY: settings.engineMode = 0; break;
+    case ocr::ENGINE_COMBINED: settings.engineMode = 2; break;
+    default: break;
+    }
+    switch (layout) {
+    case ocr::LAYOUT_AUTO: settings.pageSegMode = 3; break;
+    case ocr::LAYOUT_SINGLE_COLUMN: settings.pageSegMode = 4; break;
+    case ocr::LAYOUT_SINGLE_BLOCK: settings.pageSegMode = 6; break;
+    case ocr::LAYOUT_SINGLE_LINE: settings.pageSegMode = 7; break;
+    case ocr::LAYOUT_SINGLE_WORD: settings.pageSegMode = 8; break;
+    case ocr::LAYOUT_SPARSE_TEXT: settings.pageSegMode = 11; break;
+    default: break;
+    }
+    return settings;
+}
+
+OcrSettings ocr_settings(const ImageTask& task) {
+    return make_settings(task.language(), task.engine_mode(), task.layout());
+}
+
+OcrSettings ocr_settings(const ImageChunk& chunk) {
+    return make_settings(chunk.language(), chunk.engine_mode(), chunk.layout());
+}
+
+void fill_batch_result(BatchResult* out, int id, const OcrResult& result) {
+    out->set_id(id);
+    out->set_text(result.text);
+    out->set_processing_time_ms(result.processingTimeMs);
+
+    StageTimings* timings = out->mutable_timings();
+    timings->set_queue_wait_us(result.timings.queueWaitUs);
+    timings->set_decode_us(result.timings.decodeUs);
+    timings->set_preprocess_us(result.timings.preprocessUs);
+    timings->set_layout_us(result.timings.layoutUs);
+    timings->set_engine_wait_us(result.timings.engineWaitUs);
+    timings->set_recognition_us(result.timings.recognitionUs);
+    timings->set_total_us(result.timings.totalUs);
+}
+
+void fill_batch_error(BatchResult* out, int id, const std::string& text) {
+    out->set_id(id);
+    out->set_text(text);
+    out->set_processing_time_ms(0);
+}
+
+void fill_batch_outcome(BatchResult* out, int id,
+    std::exception_ptr error, const OcrResult& result) {
+    if (!error) {
+        fill_batch_result(out, id, result);
+        return;
+    }
+
+    try {
+        std::rethrow_exception(error);
+    }
+    catch (const DeadlineUnreachableError& ex) {
+        LOG_WARN("task rejected").kv("id", id).kv("reason", ex.what());
+        fill_batch_error(out, id, std::string("[REJECTED] ") + ex.what());
+    }
+    catch (const std::exception& ex) {
+        LOG_WARN("task failed").kv("id", id).kv("error", ex.what());
+        fill_batch_error(out, id, std::string("[ERROR] ") + ex.what());
+    }
+    catch (...) {
+        fill_batch_error(out, id, "[ERROR] unknown failure");
+    }
+}
+
+grpc::Status batch_rejected_status(ServerContext& context, std::exception_ptr error) {
+    try {
+        std::rethrow_exception(error);
+    }
+    catch (const PoolOverloadedError& ex) {
+        LOG_WARN("batch rejected").kv("reason", ex.what());
+        context.AddTrailingMetadata("retry-after-ms",
+            std::to_string(ex.retryAfter().count()));
+        return Status(grpc::StatusCode::RESOURCE_EXHAUSTED, ex.what());
+    }
+    catch (const DeadlineUnreachableError& ex) {
+        LOG_WARN("batch rejected").kv("reason", ex.what());
+        return Status(grpc::StatusCode::DEADLINE_EXCEEDED, ex.what());
+    }
+    catch (const BatchTooLargeError& ex) {
+        LOG_WARN("batch rejected").kv("reason", ex.what());
+        return Status(grpc::StatusCode::FAILED_PRECONDITION, ex.what());
+    }
+    catch (const std::exception& ex) {
+        LOG_WARN("batch rejected").kv("reason", ex.what());
+        return Status(grpc::StatusCode::INTERNAL, ex.what());
+    }
+}
+
+// Waits for fut until deadline, checking every so often whether the client
+// has gone away. Returns false if it has.
+static bool wait_for_result(std::future<OcrResult>& fut,
+    CancellationToken::Clock::time_point deadline, ServerContext* context) {
+    const auto POLL_INTERVAL = std::chrono::milliseconds(100);
+
+    while (true) {
+        auto now = CancellationToken::Clock::now();
+        if (now >= deadline) return true;
+
+        auto wakeAt = std::min(deadline, now + POLL_INTERVAL);
+        if (fut.wait_until(wakeAt) == std::future_status::ready) return true;
+
+        if (context->IsCancelled()) return false;
+    }
+}
+
+Status OCRServiceImpl::ProcessBatch(ServerContext* context,
+    const BatchRequest* request,
+    BatchResponse* reply) {
+    int taskCount = request->tasks_size();
+    LOG_DEBUG("batch received").kv("tasks", taskCount);
+
+    if (taskCount == 0) {
+        return Status(grpc::StatusCode::INVALID_ARGUMENT,
+            "BatchRequest.tasks is empty");
+    }
+
+    // Shared by every job of the call: expires at the client's deadline and
+    // is cancelled early if the client goes away.
+    const auto deadline = job_deadline(*context);
+    auto callToken = std::make_shared<CancellationToken>(deadline);
+    const JobClass jobClass = job_class(*context, request);
+
+    // The sync API hands us a const request, so this path and
+    // ProcessBatchStream still make one copy; the async ProcessBatch,
+    // Process and ProcessChunked move the bytes instead.
+    std::vector<OcrTask> tasks;
+    tasks.reserve(taskCount);
+    std::vector<int> ids;
+    ids.reserve(taskCount);
+
+    for (const auto& task : request->tasks()) {
+        LOG_DEBUG("enqueue task").kv("id", task.id()).kv("bytes", task.image_data().size());
+        ids.push_back(task.id());
+        tasks.push_back(OcrTask{ task.id(), task.image_data(), ocr_settings(task) });
+    }
+
+    // All or nothing: a refused batch leaves no jobs behind in the pool
+    std::vector<std::future<OcrResult>> futures;
+    try {
+        futures = pool_->enqueueBatch(std::move(tasks), callToken, jobClass);
+    }
+    catch (...) {
+        return batch_rejected_status(*context, std::current_exception());
+    }
+
+    // Collect results in the same order
+    for (std::size_t i = 0; i < futures.size(); ++i) {
+        if (!wait_for_result(futures[i], deadline, context)) {
+            LOG_INFO("client cancelled batch; dropping remaining tasks");
+            callToken->cancel();
+            return Status(grpc::StatusCode::CANCELLED, "Client cancelled");
+        }
+
+        if (futures[i].wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            // The call token has expired too, so the worker drops or
+            // aborts the job instead of finishing work nobody will read.
+            LOG_WARN("task timed out").kv("id", ids[i]);
+
+            fill_batch_error(reply->add_results(), ids[i],
+                "[TIMEOUT] OCR took too long");
+            continue;
+        }
+
+        try {
+            OcrResult result = futures[i].get();
+
+            fill_batch_result(reply->add_results(), ids[i], result);
+
+            LOG_DEBUG("task done").kv("id", ids[i]).kv("ms", result.processingTimeMs);
+        }
+        catch (...) {
+            fill_batch_outcome(reply->add_results(), ids[i],
+                std::current_exception(), OcrResult{});
+        }
+    }
+
+    LOG_DEBUG("batch complete").kv("results", reply->results_size());
+    return Status::OK;
+}
+
+// Enqueues one task whose result (or error) is delivered through channel.
+// The job's token expires at the job's deadline (as does its channel entry)
+// and is cancelled along with callToken if the client goes away.
+//
+// A full pool is not an error here: the call blocks (and with it the
+// stream's reader) until the pool has room, so the client is slowed down by
+// flow control rather than handed a failure.
+static void submit_to_channel(OcrWorkerPool& pool,
+    const ServerContext& context,
+    const std::shared_ptr<ResultChannel>& channel,
+    const CancelTokenPtr& callToken,
+    const JobClass& jobClass,
+    int id, std::string imageBytes, const OcrSettings& settings) {
+    auto jobToken = std::make_shared<CancellationToken>(callToken, job_deadline(context));
+    const ResultChannel::Ticket ticket = channel->expect(id, jobToken->deadline());
+
+    try {
+        pool.enqueueWhenRoom(id, std::move(imageBytes),
+            [channel, ticket, id](std::exception_ptr error, OcrResult result) {
+                BatchResult out;
+                fill_batch_outcome(&out, id, error, result);
+                channel->push(ticket, std::move(out));
+            },
+            jobToken, jobClass, settings);
+    }
+    catch (...) {
+        BatchResult out;
+        fill_batch_outcome(&out, id, std::current_exception(), OcrResult{});
+        channel->push(ticket, std::move(out));
+    }
+}
+
+// Most uploads one stream may have queued or running at once. Past that its
+// reader stops reading, so the client is held back by HTTP/2 flow control.
+static std::size_t stream_window(const OcrWorkerPool& pool) {
+    return 2 * pool.workerCount();
+}
+
+Status OCRServiceImpl::ProcessBatchStream(ServerContext* context,
+    const BatchRequest* request,
+    ServerWriter<BatchResult>* writer) {
+    int taskCount = request->tasks_size();
+    LOG_DEBUG("streaming batch received").kv("tasks", taskCount);
+
+    if (taskCount == 0) {
+        return Status(grpc::StatusCode::INVALID_ARGUMENT,
+            "BatchRequest.tasks is empty");
+    }
+
+    // Workers push into the channel as they finish; this thread only writes.
+    // The whole batch is admitted up front, as for ProcessBatch.
+    auto channel = std::make_shared<ResultChannel>();
+    auto callToken = std::make_shared<CancellationToken>(job_deadline(*context));
+
+    std::vector<OcrTask> tasks;
+    tasks.reserve(taskCount);
+    std::vector<int> ids;
+    ids.reserve(taskCount);
+    std::vector<ResultChannel::Ticket> tickets;
+    tickets.reserve(taskCount);
+    // Const request: each image is copied once, as in ProcessBatch
+    for (const auto& task : request->tasks()) {
+        ids.push_back(task.id());
+        tasks.push_back(OcrTask{ task.id(), task.image_data(), ocr_settings(task) });
+        tickets.push_back(channel->expect(task.id(), callToken->deadline()));
+    }
+
+    try {
+        pool_->enqueueBatch(std::move(tasks),
+            [channel, ids, tickets](std::size_t index, std::exception_ptr error,
+                OcrResult result) {
+                BatchResult out;
+                fill_batch_outcome(&out, ids[index], error, result);
+                channel->push(tickets[index], std::move(out));
+            },
+            callToken, job_class(*context, request));
+    }
+    catch (...) {
+        return batch_rejected_status(*context, std::current_exception());
+    }
+    channel->close();
+
+    auto clientGone = [context] { return context->IsCancelled(); };
+
+    bool writeFailed = false;
+    BatchResult result;
+    while (channel->next(result, clientGone)) {
+        if (!writer->Write(result)) {
+            writeFailed = true;
+            break;
+        }
+    }
+
+    if (writeFailed || context->IsCancelled()) {
+        // Stopped early: drop whatever is still queued for this client
+        callToken->cancel();
+        LOG_INFO("client went away during streaming batch");
+        return Status(grpc::StatusCode::CANCELLED, "Client disconnected");
+    }
+
+    LOG_DEBUG("streaming batch complete");
+    return Status::OK;
+}
+
+// Runs readLoop on a helper thread (it must close the channel when the
+// client is done uploading) while this thread writes results back as they
+// complete. If the client goes away, callToken is cancelled so its queued
+// and running jobs are dropped.
+template <class Stream>
+static Status pump_results(ServerContext* context, Stream* stream,
+    const std::shared_ptr<ResultChannel>& channel,
+    const std::shared_ptr<CancellationToken>& callToken,
+    const std::function<void()>& readLoop) {
+    std::thread reader(readLoop);
+
+    auto clientGone = [context] { return context->IsCancelled(); };
+
+    bool writeFailed = false;
+    BatchResult result;
+    while (channel->next(result, clientGone)) {
+        if (!stream->Write(result)) {
+            writeFailed = true;
+            break;
+        }
+    }
+
+    const bool cancelled = writeFailed || context->IsCancelled();
+    if (cancelled) {
+        callToken->cancel();
+    }
+    reader.join();
+
+    if (cancelled) {
+        LOG_INFO("client went away during processing stream");
+        return Status(grpc::StatusCode::CANCELLED, "Client disconnected");
+    }
+    return Status::OK;
+}
+
+Status OCRServiceImpl::Process(ServerContext* context,
+    ServerReaderWriter<BatchResult, ImageTask>* stream) {
+    LOG_DEBUG("processing stream opened");
+
+    auto channel = std::make_shared<ResultChannel>();
+    auto callToken = std::make_shared<CancellationToken>();
+
+    // Uploads go straight into the pool as they arrive, at most window of
+    // them at a time
+    const std::size_t window = stream_window(*pool_);
+    auto stopReading = [context, &callToken] {
+        return context->IsCancelled() || callToken->isCancelled();
+    };
+    const JobClass jobClass = job_class(*context);
+
+    int received = 0;
+    Status status = pump_results(context, stream, channel, callToken, [&] {
+        ImageTask task;
+        while (channel->waitForRoom(window, stopReading) && stream->Read(&task)) {
+            ++received;
+            submit_to_channel(*pool_, *context, channel, callToken, jobClass, task.id(),
+                std::move(*task.mutable_image_data()), ocr_settings(task));
+        }
+        channel->close();
+    });
+
+    LOG_DEBUG("processing stream complete").kv("tasks", received);
+    return status;
+}
+
+Status OCRServiceImpl::ProcessChunked(ServerContext* context,
+    ServerReaderWriter<BatchResult, ImageChunk>* stream) {
+    LOG_DEBUG("chunked stream opened");
+
+    // Largest image accepted: an uncompressed 300 dpi A4 colour scan is
+    // about 26 MB, so this leaves room for 600 dpi greyscale while keeping a
+    // client from announcing gigabytes.
+    const std::int64_t MAX_IMAGE_BYTES = 64LL * 1024 * 1024;
+
+    auto channel = std::make_shared<ResultChannel>();
+    auto callToken = std::make_shared<CancellationToken>();
+
+    // Reports a bad upload as that image's result; the stream carries on.
+    auto reject = [&](int id, const std::string& why) {
+        const ResultChannel::Ticket ticket = channel->expect(id,
+            ResultChannel::Clock::time_point::max());
+        BatchResult out;
+        fill_batch_error(&out, id, "[ERROR] " + why);
+        channel->push(ticket, std::move(out));
+    };
+
+    // Chunks of a new image are only read while the stream has room for it
+    const std::size_t window = stream_window(*pool_);
+    auto stopReading = [context, &callToken] {
+        return context->IsCancelled() || callToken->isCancelled();
+    };
+    const JobClass jobClass = job_class(*context);
+
+    int received = 0;
+    Status status = pump_results(context, stream, channel, callToken, [&] {
+        // Images being assembled, keyed by task id. Chunks must arrive in
+        // order, so bytes.size() is the offset the next one has to start at;
+        // the buffer grows as data arrives, never past total, and is then
+        // moved into the worker pool. Each upload holds total bytes of the
+        // server-wide reassembly budget until it is submitted or dropped.
+        struct Upload {
+            std::string bytes;
+            std::size_t total = 0;
+            OcrSettings settings;
+        };
+        std::unordered_map<int, Upload> partial;
+
+        // Ids whose upload was answered with an error; their remaining
+        // chunks are skipped until a new upload starts at offset 0. Once
+        // the set is full it is forgotten, and stray chunks of those ids
+        // are answered with another error instead.
+        const std::size_t MAX_FAILED_IDS = 4096;
+        std::unordered_set<int> failed;
+
+        auto fail = [&](int id, const std::string& why) {
+            auto it = partial.find(id);
+            if (it != partial.end()) {
+                releaseReassembly(it->second.total);
+                partial.erase(it);
+            }
+            if (failed.size() >= MAX_FAILED_IDS) failed.clear();
+            failed.insert(id);
+            reject(id, why);
+        };
+
+        ImageChunk chunk;
+        while (stream->Read(&chunk)) {
+            const int id = chunk.id();
+            auto it = partial.find(id);
+            if (it == partial.end()) {
+                if (failed.count(id)) {
+                    if (chunk.offset() != 0) continue;
+                    failed.erase(id);
+                }
+
+                // Images still being uploaded count against the window too:
+                // they can only finish if this loop keeps reading, so a new
+                // one is refused rather than waited for when they fill it.
+                if (partial.size() >= window) {
+                    fail(id, "too many images uploading at once on this stream");
+                    continue;
+                }
+                if (!channel->waitForRoom(window - partial.size(), stopReading)) {
+                    break;
+                }
+
+                if (chunk.offset() != 0 || chunk.total_size() <= 0
+                    || chunk.total_size() > MAX_IMAGE_BYTES) {
+                    fail(id, "invalid first chunk");
+                    continue;
+                }
+                const auto total = static_cast<std::size_t>(chunk.total_size());
+                if (!reserveReassembly(total)) {
+                    fail(id, "server is reassembling too many images, retry later");
+                    continue;
+                }
+                Upload upload;
+                upload.total = total;
+                upload.settings = ocr_settings(chunk);
+                it = partial.emplace(id, std::move(upload)).first;
+            }
+
+            Upload& upload = it->second;
+            std::string& buffer = upload.bytes;
+            const std::string& data = chunk.data();
+            if (chunk.offset() != static_cast<std::int64_t>(buffer.size())) {
+                fail(id, "chunk out of order: expected offset " + std::to_string(buffer.size()));
+                continue;
+            }
+            if (data.size() > upload.total - buffer.size()) {
+                fail(id, "chunk outside announced image size");
+                continue;
+            }
+            const std::size_t needed = buffer.size() + data.size();
+            if (needed > buffer.capacity()) {
+                buffer.reserve(std::min(upload.total, std::max(needed, buffer.capacity() * 2)));
+            }
+            buffer.append(data);
+
+            if (chunk.last()) {
+                if (buffer.size() != upload.total) {
+                    fail(id, "image ended before total_size bytes");
+                    continue;
+                }
+                ++received;
+                submit_to_channel(*pool_, *context, channel, callToken, jobClass, id,
+                    std::move(buffer), upload.settings);
+                releaseReassembly(upload.total);
+                partial.erase(it);
+            }
+        }
+
+        for (const auto& p : partial) {
+            releaseReassembly(p.second.total);
+            reject(p.first, "upload incomplete");
+        }
+        channel->close();
+    });
+
+    LOG_DEBUG("chunked stream complete").kv("images", received);
+    return status;
+}
+
+bool OCRServiceImpl::reserveReassembly(std::size_t bytes) {
+    std::size_t used = reassemblyBytes_.load();
+    do {
+        if (bytes > MAX_REASSEMBLY_BYTES - used) return false;
+    } while (!reassemblyBytes_.compare_exchange_weak(used, used + bytes));
+    return true;
+}
+
+void OCRServiceImpl::releaseReassembly(std::size_t bytes) {
+    reassemblyBytes_ -= bytes;
+}
+
+std::string prometheus_metrics(const OcrWorkerPool& pool) {
+    PrometheusWriter out;
+
+    out.gauge("ocr_workers", "Workers taking jobs; fewer than the maximum when the pool is elastic.",
+        static_cast<double>(pool.workerCount()));
+    out.gauge("ocr_workers_max", "Worker threads in the pool, including parked ones.",
+        static_cast<double>(pool.maxWorkers()));
+    out.gauge("ocr_active_workers", "Workers running a job or page region right now.",
+        static_cast<double>(pool.activeJobs()));
+    out.gauge("ocr_queue_depth", "Jobs and page regions waiting for a worker.",
+        static_cast<double>(pool.queuedJobs()));
+    for (const auto& s : pool.classStats()) {
+        const std::string labels = std::string("priority=\"") + priority_name(s.priority) + "\"";
+        out.gauge("ocr_class_queued", "Queued jobs by priority class.",
+            static_cast<double>(s.queued), labels);
+        out.gauge("ocr_class_oldest_wait_seconds",
+            "Age of the longest-waiting queued job by priority class.",
+            s.oldestWaitMs / 1000.0, labels);
+    }
+
+    const PoolCounters& counters = pool.counters();
+    const char* imagesHelp = "Images handed back to callers, by outcome.";
+    out.counter("ocr_images_total", imagesHelp, counters.completed.value(), "outcome=\"ok\"");
+    out.counter("ocr_images_total", imagesHelp, counters.failed.value(), "outcome=\"error\"");
+    out.counter("ocr_images_total", imagesHelp, counters.cancelled.value(),
+        "outcome=\"cancelled\"");
+    out.counter("ocr_images_total", imagesHelp, counters.timedOut.value(),
+        "outcome=\"timeout\"");
+    out.counter("ocr_image_bytes_total", "Encoded bytes of images completed successfully.",
+        counters.completedBytes.value());
+    const char* rejectedHelp = "Images refused at admission, by reason.";
+    out.counter("ocr_rejected_total", rejectedHelp, counters.rejectedQueueFull.value(),
+        "reason=\"queue_full\"");
+    out.counter("ocr_rejected_total", rejectedHelp, counters.rejectedDeadline.value(),
+        "reason=\"deadline\"");
+    out.counter("ocr_rejected_total", rejectedHelp, counters.rejectedTooLarge.value(),
+        "reason=\"batch_too_large\"");
+    out.counter("ocr_coalesced_total",
+        "Duplicate images attached to an identical in-flight job.", pool.coalescedJobs());
+
+    if (const ResultCache* cache = pool.cache()) {
+        const ResultCacheStats stats = cache->stats();
+        out.counter("ocr_cache_lookups_total", "Result cache lookups.", stats.lookups);
+        const char* hitsHelp = "Result cache hits, by tier.";
+        out.counter("ocr_cache_hits_total", hitsHelp, stats.memoryHits, "tier=\"memory\"");
+        out.counter("ocr_cache_hits_total", hitsHelp, stats.diskHits, "tier=\"disk\"");
+        out.gauge("ocr_cache_entries", "Results held in memory.",
+            static_cast<double>(stats.entries));
+        out.gauge("ocr_cache_memory_bytes", "Memory used by cached results.",
+            static_cast<double>(stats.memoryBytes));
+        out.gauge("ocr_cache_disk_entries", "Result files in the disk tier.",
+            static_cast<double>(stats.diskEntries));
+        out.gauge("ocr_cache_disk_bytes", "Disk used by the disk tier, in whole blocks.",
+            static_cast<double>(stats.diskBytes));
+    }
+
+    const StageLatencies& latencies = pool.stageLatencies();
+    const std::pair<const char*, const LatencyHistogram*> stages[] = {
+        { "queue_wait", &latencies.queueWait },
+        { "decode", &latencies.decode },
+        { "preprocess", &latencies.preprocess },
+        { "layout", &latencies.layout },
+        { "engine_wait", &latencies.engineWait },
+        { "recognition", &latencies.recognition },
+        { "total", &latencies.total },
+    };
+    for (const auto& stage : stages) {
+        out.latencyHistogram("ocr_stage_latency_seconds",
+            "Time spent in each stage of successfully completed images.",
+            stage.second->snapshot(), std::string("stage=\"") + stage.first + "\"");
+    }
+
+    return out.str();
+}
+
+Status OCRServiceImpl::GetStats(ServerContext* /*context*/,
+    const StatsRequest* /*request*/, StatsResponse* reply) {
+    reply->set_prometheus_text(prometheus_metrics(*pool_));
+    reply->set_queue_depth(static_cast<int>(pool_->queuedJobs()));
+    reply->set_active_workers(static_cast<int>(pool_->activeJobs()));
+    reply->set_workers(static_cast<int>(pool_->workerCount()));
+    return Status::OK;
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <grpcpp/grpcpp.h>
+#include "ocr_service.grpc.pb.h"
+
+#include "CancellationToken.h"
+#include "OcrProcessor.h"
+#include "OcrWorkerPool.h"
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <string>
+
+// Deadline for a job submitted now: the client's propagated gRPC deadline,
+// or a server default budget from now if the client did not set one.
+CancellationToken::Clock::time_point job_deadline(const grpc::ServerContext& context);
+
+// Priority class and fair-share client of a call. Taken from request when
+// given, otherwise from the "ocr-priority" and "ocr-client-id" metadata;
+// the client defaults to the caller's address.
+JobClass job_class(const grpc::ServerContext& context,
+    const ocr::BatchRequest* request = nullptr);
+
+// Recognition settings requested for one image; fields the client left
+// unset keep OcrSettings' defaults. ImageChunk carries them on the first
+// chunk of each image.
+OcrSettings ocr_settings(const ocr::ImageTask& task);
+OcrSettings ocr_settings(const ocr::ImageChunk& chunk);
+
+void fill_batch_result(ocr::BatchResult* out, int id, const OcrResult& result);
+void fill_batch_error(ocr::BatchResult* out, int id, const std::string& text);
+
+// Fills either the result or an "[ERROR] ..." / "[REJECTED] ..." entry from
+// a pool callback.
+void fill_batch_outcome(ocr::BatchResult* out, int id,
+    std::exception_ptr error, const OcrResult& result);
+
+// Status for a batch the pool refused at admission: RESOURCE_EXHAUSTED with
+// a "retry-after-ms" trailer when the queue is full, DEADLINE_EXCEEDED when
+// the batch cannot finish in time, FAILED_PRECONDITION (no retry hint) when
+// it is larger than the whole queue.
+grpc::Status batch_rejected_status(grpc::ServerContext& context, std::exception_ptr error);
+
+// The pool's load, outcome counters, per-stage latencies and cache hits in
+// the Prometheus text format.
+std::string prometheus_metrics(const OcrWorkerPool& pool);
+
+// Synchronous service. Default-constructible so it can be wrapped in the
+// generated WithAsyncMethod_* templates; call attachPool() before use.
+class OCRServiceImpl : public ocr::OCRService::Service {
+public:
+    void attachPool(OcrWorkerPool& pool) { pool_ = &pool; }
+
+    grpc::Status ProcessBatch(grpc::ServerContext* context,
+        const ocr::BatchRequest* request,
+        ocr::BatchResponse* reply) override;
+
+    grpc::Status ProcessBatchStream(grpc::ServerContext* context,
+        const ocr::BatchRequest* request,
+        grpc::ServerWriter<ocr::BatchResult>* writer) override;
+
+    grpc::Status Process(grpc::ServerContext* context,
+        grpc::ServerReaderWriter<ocr::BatchResult, ocr::ImageTask>* stream) override;
+
+    grpc::Status ProcessChunked(grpc::ServerContext* context,
+        grpc::ServerReaderWriter<ocr::BatchResult, ocr::ImageChunk>* stream) override;
+
+    grpc::Status GetStats(grpc::ServerContext* context,
+        const ocr::StatsRequest* request,
+        ocr::StatsResponse* reply) override;
+
+protected:
+    // Memory all ProcessChunked streams together may hold in images still
+    // being reassembled: four of the largest images accepted.
+    static constexpr std::size_t MAX_REASSEMBLY_BYTES = 256u * 1024 * 1024;
+
+    // Claims bytes of that budget for one upload; false if it is used up.
+    bool reserveReassembly(std::size_t bytes);
+    void releaseReassembly(std::size_t bytes);
+
+    OcrWorkerPool* pool_ = nullptr;
+    std::atomic<std::size_t> reassemblyBytes_{ 0 };
+};
@@ -1,20 +1,88 @@
 #include "OcrWorkerPool.h"
+#include "Logger.h"
 
-#include <iostream>
+#include <algorithm>
+#include <atomic>
 #include <stdexcept>
+#include <string>
 
+// Weight of the newest sample in the service-time estimate.
+static const double SERVICE_TIME_ALPHA = 0.2;
 
-OcrWorkerPool::OcrWorkerPool(std::size_t numThreads, std::size_t maxQueueSize)
+// Fair-queuing weight of each priority class, indexed by JobPriority: while
+// both have work queued, an interactive flow gets 16 turns for every turn
+// of a bulk flow.
+static const double CLASS_WEIGHT[JOB_PRIORITY_COUNT] = { 4.0, 16.0, 1.0 };
+
+// Upper bound on the regions of one tiled page, per worker. A few per
+// worker evens out regions of different sizes without drowning short
+// blocks in per-job overhead.
+static const std::size_t TILE_REGIONS_PER_WORKER = 4;
+
+const char* priority_name(JobPriority priority) {
+    switch (priority) {
+    case JobPriority::Interactive: return "interactive";
+    case JobPriority::Bulk: return "bulk";
+    default: return "normal";
+    }
+}
+
+static long long micros_between(CancellationToken::Clock::time_point from,
+    CancellationToken::Clock::time_point to) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(to - from).count();
+}
+
+// Hands a finished job's outcome to whoever is waiting for it.
+static void complete_job(OcrJob& job, std::exception_ptr error, OcrResult result) {
+    if (job.onDone) {
+        job.onDone(error, std::move(result));
+    }
+    else if (error) {
+        job.promise.set_exception(error);
+    }
+    else {
+        job.promise.set_value(std::move(result));
+    }
+}
+
+static std::shared_ptr<OcrJob> make_job(int id, std::string imageBytes,
+    const OcrSettings& settings, CancelTokenPtr cancel, const JobClass& jobClass) {
+    auto job = std::make_shared<OcrJob>();
+    job->id = id;
+    job->imageBytes = std::move(imageBytes);
+    job->settings = settings;
+    job->sizeBytes = job->imageBytes.size();
+    job->cancel = std::move(cancel);
+    job->jobClass = jobClass;
+    job->receivedAt = CancellationToken::Clock::now();
+    if (job->cancel) job->deadline = job->cancel->deadline();
+    return job;
+}
+
+
+OcrWorkerPool::OcrWorkerPool(std::size_t numThreads, std::size_t maxQueueSize,
+    PoolScheduling scheduling, WorkerStartHook onWorkerStart, std::vector<int> workerNodes)
     : maxQueueSize_(maxQueueSize) {
     if (numThreads == 0) numThreads = 1;
     if (maxQueueSize_ == 0) maxQueueSize_ = 100; // sensible default
 
-    for (std::size_t i = 0; i < numThreads; ++i) {
-        workers_.emplace_back(&OcrWorkerPool::workerLoop, this, static_cast<int>(i));
+    if (scheduling == PoolScheduling::WorkStealing) {
+        stealing_ = std::make_unique<WorkStealingScheduler>(numThreads, std::move(onWorkerStart),
+            std::move(workerNodes));
+    }
+    else {
+        activeWorkers_ = numThreads;
+        for (std::size_t i = 0; i < numThreads; ++i) {
+            workers_.emplace_back([this, i, onWorkerStart] {
+                if (onWorkerStart) onWorkerStart(i);
+                workerLoop(static_cast<int>(i));
+            });
+        }
     }
 
-    std::cout << "OcrWorkerPool started with " << numThreads
-        << " threads, maxQueueSize=" << maxQueueSize_ << ".\n";
+    LOG_INFO("worker pool started").kv("threads", numThreads)
+        .kv("max_queue", maxQueueSize_)
+        .kv("scheduling", stealing_ ? "work-stealing" : "earliest-deadline-first");
 }
 
 OcrWorkerPool::~OcrWorkerPool() {
@@ -23,61 +91,767 @@ OcrWorkerPool::~OcrWorkerPool() {
         stopping_ = true;
     }
     cv_.notify_all();
+    roomCv_.notify_all();
+    parkCv_.notify_all();
 
     for (auto& t : workers_) {
         if (t.joinable()) t.join();
     }
+    // Runs whatever is still queued, then joins its threads
+    stealing_.reset();
 
-    std::cout << "OcrWorkerPool stopped.\n";
+    LOG_INFO("worker pool stopped");
 }
 
-std::future<OcrResult> OcrWorkerPool::enqueue(int id, const std::string& imageBytes) {
-    auto job = std::make_shared<OcrJob>();
-    job->id = id;
-    job->imageBytes = imageBytes;
+std::future<OcrResult> OcrWorkerPool::enqueue(int id, std::string imageBytes,
+    CancelTokenPtr cancel, const JobClass& jobClass,
+    const OcrSettings& settings) {
+    auto job = make_job(id, std::move(imageBytes), settings, std::move(cancel), jobClass);
 
     std::future<OcrResult> fut = job->promise.get_future();
+    push(std::move(job));
+    return fut;
+}
+
+void OcrWorkerPool::enqueue(int id, std::string imageBytes, OcrCallback onDone,
+    CancelTokenPtr cancel, const JobClass& jobClass,
+    const OcrSettings& settings) {
+    auto job = make_job(id, std::move(imageBytes), settings, std::move(cancel), jobClass);
+    job->onDone = std::move(onDone);
+
+    push(std::move(job));
+}
+
+void OcrWorkerPool::enqueueWhenRoom(int id, std::string imageBytes, OcrCallback onDone,
+    CancelTokenPtr cancel, const JobClass& jobClass,
+    const OcrSettings& settings) {
+    auto job = make_job(id, std::move(imageBytes), settings, std::move(cancel), jobClass);
+    job->onDone = std::move(onDone);
+
+    std::vector<std::shared_ptr<OcrJob>> jobs;
+    jobs.push_back(std::move(job));
+    pushBatch(std::move(jobs), /*waitForRoom*/ true);
+}
+
+std::vector<std::future<OcrResult>> OcrWorkerPool::enqueueBatch(
+    std::vector<OcrTask> tasks, CancelTokenPtr cancel, const JobClass& jobClass) {
+    std::vector<std::shared_ptr<OcrJob>> jobs;
+    std::vector<std::future<OcrResult>> futures;
+    jobs.reserve(tasks.size());
+    futures.reserve(tasks.size());
+
+    for (auto& task : tasks) {
+        auto job = make_job(task.id, std::move(task.imageBytes), task.settings, cancel,
+            jobClass);
+        futures.push_back(job->promise.get_future());
+        jobs.push_back(std::move(job));
+    }
+
+    pushBatch(std::move(jobs), /*waitForRoom*/ false);
+    return futures;
+}
+
+void OcrWorkerPool::enqueueBatch(std::vector<OcrTask> tasks,
+    const OcrBatchCallback& onDone, CancelTokenPtr cancel, const JobClass& jobClass) {
+    std::vector<std::shared_ptr<OcrJob>> jobs;
+    jobs.reserve(tasks.size());
+
+    for (std::size_t i = 0; i < tasks.size(); ++i) {
+        auto job = make_job(tasks[i].id, std::move(tasks[i].imageBytes), tasks[i].settings,
+            cancel, jobClass);
+        job->onDone = [onDone, i](std::exception_ptr error, OcrResult result) {
+            onDone(i, error, std::move(result));
+        };
+        jobs.push_back(std::move(job));
+    }
+
+    pushBatch(std::move(jobs), /*waitForRoom*/ false);
+}
+
+void OcrWorkerPool::push(std::shared_ptr<OcrJob> job) {
+    std::vector<std::shared_ptr<OcrJob>> jobs;
+    jobs.push_back(std::move(job));
+    pushBatch(std::move(jobs), /*waitForRoom*/ false);
+}
+
+void OcrWorkerPool::pushBatch(std::vector<std::shared_ptr<OcrJob>> jobs, bool waitForRoom) {
+    if (jobs.empty()) return;
+
+    for (auto& job : jobs) {
+        job->contentKey = ResultCache::makeKey(job->imageBytes, ocr_config_key(job->settings),
+            hashKey_);
+    }
+
+    // Images seen before are answered from the cache. They are only
+    // completed once the rest of the batch has been admitted, so a refused
+    // batch still runs no callbacks at all.
+    std::vector<std::pair<std::shared_ptr<OcrJob>, std::string>> hits;
+    if (cache_) {
+        std::vector<std::shared_ptr<OcrJob>> misses;
+        misses.reserve(jobs.size());
+
+        for (auto& job : jobs) {
+            std::string text;
+            if (cache_->lookup(job->contentKey, text)) {
+                hits.emplace_back(std::move(job), std::move(text));
+            }
+            else {
+                misses.push_back(std::move(job));
+            }
+        }
+        jobs = std::move(misses);
+    }
+
+    if (!jobs.empty()) {
+        admitBatch(std::move(jobs), waitForRoom);
+    }
+
+    for (auto& hit : hits) {
+        LOG_DEBUG("cache hit").kv("id", hit.first->id);
+        OcrResult result{ std::move(hit.second), 0, {} };
+        result.timings.totalUs = micros_between(hit.first->receivedAt,
+            CancellationToken::Clock::now());
+        recordLatencies(result.timings, /*recognized*/ false);
+        countOutcome(*hit.first, nullptr);
+        complete_job(*hit.first, nullptr, std::move(result));
+    }
+}
+
+static bool can_carry(const OcrJob& leader, const OcrJob& rider) {
+    if (leader.started) return true;
+    return leader.deadline <= rider.deadline
+        && CLASS_WEIGHT[static_cast<int>(leader.jobClass.priority)]
+            >= CLASS_WEIGHT[static_cast<int>(rider.jobClass.priority)];
+}
+
+void OcrWorkerPool::admitBatch(std::vector<std::shared_ptr<OcrJob>> jobs, bool waitForRoom) {
+    // How often a blocked producer re-checks its token
+    const auto ROOM_POLL_INTERVAL = std::chrono::milliseconds(100);
+
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+
+        // Single flight: a job whose image is already queued or running, or
+        // appears earlier in this batch, rides along with that job instead
+        // of taking a slot and running Tesseract a second time. A queued
+        // job only takes riders it does not hold back: due no later and in
+        // a class served at least as eagerly. Otherwise the rider queues on
+        // its own and later duplicates attach to it instead.
+        std::vector<std::shared_ptr<OcrJob>> leaders;
+        std::vector<std::pair<std::shared_ptr<OcrJob>, std::shared_ptr<OcrJob>>> riders; // (job, leader)
+        auto splitDuplicates = [&] {
+            leaders.clear();
+            riders.clear();
+            std::unordered_map<ResultCacheKey, std::shared_ptr<OcrJob>, ResultCacheKeyHash> firstInBatch;
+            for (const auto& job : jobs) {
+                auto running = inFlight_.find(job->contentKey);
+                if (running != inFlight_.end() && can_carry(*running->second, *job)) {
+                    riders.emplace_back(job, running->second);
+                    continue;
+                }
+                auto earlier = firstInBatch.find(job->contentKey);
+                if (earlier != firstInBatch.end()) {
+                    riders.emplace_back(job, earlier->second);
+                    continue;
+                }
+                firstInBatch.emplace(job->contentKey, job);
+                leaders.push_back(job);
+            }
+        };
+        splitDuplicates();
+
+        // No amount of waiting makes room for more than the whole queue
+        if (leaders.size() > maxQueueSize_) {
+            counters_.rejectedTooLarge.add(jobs.size());
+            throw BatchTooLargeError(
+                "Batch too large: " + std::to_string(leaders.size())
+                + " distinct images, the queue holds at most "
+                + std::to_string(maxQueueSize_) + "; split it into smaller batches");
+        }
+
+        if (waitForRoom) {
+            const auto& cancel = jobs.front()->cancel;
+            while (queued_ - queuedRegions_ + leaders.size() > maxQueueSize_ && !stopping_) {
+                if (cancel && cancel->isCancelled()) {
+                    throw OcrCancelledError("Job cancelled while waiting for queue space");
+                }
+                roomCv_.wait_for(lock, ROOM_POLL_INTERVAL);
+                splitDuplicates();
+            }
+        }
+
+        // Capacity is checked for the whole batch up front, so a batch is
+        // either queued completely or not at all.
+        // Regions of pages already admitted do not take slots.
+        const std::size_t queuedPages = queued_ - queuedRegions_;
+        if (queuedPages + leaders.size() > maxQueueSize_) {
+            counters_.rejectedQueueFull.add(jobs.size());
+            throw PoolOverloadedError(
+                "Server overloaded: job queue is full ("
+                + std::to_string(queuedPages) + "/" + std::to_string(maxQueueSize_)
+                + " queued, " + std::to_string(leaders.size()) + " requested)",
+                retryAfterLocked());
+        }
+
+
+        double batchMs = 0.0;
+        double longestMs = 0.0;
+        for (auto& job : leaders) {
+            job->estimatedMs = estimateMsLocked(job->sizeBytes);
+            batchMs += job->estimatedMs;
+            longestMs = std::max(longestMs, job->estimatedMs);
+        }
+
+        // Admission: count the jobs due no later than these as the backlog
+        // they wait behind. Flows interleave, so this is an estimate. Jobs
+        // of one batch share a deadline, so the batch is admitted or
+        // refused as a whole.
+        const auto deadline = jobs.front()->deadline;
+        if (deadline != CancellationToken::Clock::time_point::max()
+            && msPerByte_ > 0.0) {
+            double aheadMs = 0.0;
+            if (stealing_) {
+                // No global order: assume everything queued goes first
+                aheadMs = queuedMs_;
+            }
+            else {
+                for (const auto& entry : flows_) {
+                    for (const auto& queued : entry.second.jobs) {
+                        if (queued->deadline > deadline) break;
+                        aheadMs += queued->estimatedMs;
+                    }
+                }
+            }
+            // The batch's own jobs spread over the workers too; the longest
+            // one is the last to finish.
+            const double needMs = (aheadMs + batchMs - longestMs)
+                / static_cast<double>(workerCount()) + longestMs;
+
+            const double budgetMs = std::chrono::duration<double, std::milli>(
+                deadline - CancellationToken::Clock::now()).count();
+            if (needMs > budgetMs) {
+                counters_.rejectedDeadline.add(jobs.size());
+                throw DeadlineUnreachableError(
+                    "Deadline cannot be met: needs ~" + std::to_string(
+                        static_cast<long long>(needMs))
+                    + "ms, " + std::to_string(static_cast<long long>(budgetMs))
+                    + "ms left");
+            }
+        }
+
+        // Nothing below throws; from here on the batch is accepted.
+        for (auto& rider : riders) {
+            auto& leader = rider.second;
+            leader->followers.push_back(rider.first);
+            // A re-queued job brings its own riders along
+            for (auto& f : rider.first->followers) leader->followers.push_back(std::move(f));
+            rider.first->followers.clear();
+            ++coalesced_;
+            LOG_DEBUG("attached to in-flight job").kv("id", rider.first->id)
+                .kv("leader", leader->id);
+        }
+        jobs = std::move(leaders);
+
+        for (auto& job : jobs) {
+            inFlight_[job->contentKey] = job;
+        }
+        queueLocked(jobs);
+    }
+
+    dispatch(std::move(jobs));
+}
+
+// Counts jobs as queued and, on the shared queue, files them into their
+// flows. Capacity and deadlines must already have been checked.
+void OcrWorkerPool::queueLocked(const std::vector<std::shared_ptr<OcrJob>>& jobs) {
+    const auto now = CancellationToken::Clock::now();
+    for (auto& job : jobs) {
+        job->seq = nextSeq_++;
+        job->enqueuedAt = now;
+        queuedMs_ += job->estimatedMs;
+        ++queued_;
+        if (job->regionWork) ++queuedRegions_;
+        ++classCounters_[static_cast<int>(job->jobClass.priority)].queued;
+
+        if (!stealing_) {
+            insertLocked(job);
+        }
+    }
+}
+
+// Wakes workers for jobs queued by queueLocked(), or in WorkStealing mode
+// hands them to the scheduler. Called after mutex_ is released.
+void OcrWorkerPool::dispatch(std::vector<std::shared_ptr<OcrJob>> jobs) {
+    if (jobs.empty()) return; // all attached to jobs already in flight
+
+    if (stealing_) {
+        // The whole batch in one operation
+        std::vector<WorkStealingScheduler::Task> tasks;
+        tasks.reserve(jobs.size());
+        for (auto& job : jobs) {
+            tasks.push_back([this, job = std::move(job)] {
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    noteStartedLocked(*job);
+                }
+                roomCv_.notify_one();
+                runJob(WorkStealingScheduler::currentWorker(), job);
+                });
+        }
+        stealing_->submitBatch(std::move(tasks));
+        return;
+    }
+
+    if (jobs.size() == 1) {
+        cv_.notify_one();
+    }
+    else {
+        cv_.notify_all();
+    }
+}
+
+std::uint64_t OcrWorkerPool::coalescedJobs() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return coalesced_;
+}
+
+std::size_t OcrWorkerPool::queuedJobs() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return queued_;
+}
+
+std::size_t OcrWorkerPool::workerCount() const {
+    return stealing_ ? stealing_->workerCount() : activeWorkers_.load();
+}
+
+std::size_t OcrWorkerPool::maxWorkers() const {
+    return stealing_ ? stealing_->maxWorkers() : workers_.size();
+}
+
+void OcrWorkerPool::setActiveWorkers(std::size_t count) {
+    if (stealing_) {
+        stealing_->setActiveWorkers(count);
+        return;
+    }
 
     {
         std::lock_guard<std::mutex> lock(mutex_);
-        if (queue_.size() >= maxQueueSize_) {
-            throw std::runtime_error("Server overloaded: job queue is full");
+        activeWorkers_ = std::clamp<std::size_t>(count, 1, workers_.size());
+    }
+    // Idle workers above the new count move over to parkCv_
+    cv_.notify_all();
+    parkCv_.notify_all();
+}
+
+std::vector<PoolClassStats> OcrWorkerPool::classStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    std::vector<PoolClassStats> stats(JOB_PRIORITY_COUNT);
+    for (int p = 0; p < JOB_PRIORITY_COUNT; ++p) {
+        stats[p].priority = static_cast<JobPriority>(p);
+        stats[p].queued = classCounters_[p].queued;
+        stats[p].started = classCounters_[p].started;
+        stats[p].avgWaitMs = classCounters_[p].avgWaitMs;
+    }
+
+    // Only the shared queue can be inspected; the work-stealing deques
+    // report depth and average wait only.
+    const auto now = CancellationToken::Clock::now();
+    for (const auto& entry : flows_) {
+        for (const auto& job : entry.second.jobs) {
+            const double waitMs = std::chrono::duration<double, std::milli>(
+                now - job->enqueuedAt).count();
+            double& oldest = stats[entry.first.first].oldestWaitMs;
+            oldest = std::max(oldest, waitMs);
         }
-        queue_.push(job);
     }
-    cv_.notify_one();
+    return stats;
+}
 
-    return fut;
+void OcrWorkerPool::insertLocked(std::shared_ptr<OcrJob> job) {
+    const int priority = static_cast<int>(job->jobClass.priority);
+    Flow& flow = flows_[{ priority, job->jobClass.client }];
+
+    // Self-clocked fair queuing: a job's finish tag is its size scaled down
+    // by its class weight, counted from wherever its flow or the pool
+    // (whichever is further along) has got to.
+    const double cost = static_cast<double>(std::max<std::size_t>(job->sizeBytes, 1));
+    const double tag = std::max(virtualTime_, flow.lastTag) + cost / CLASS_WEIGHT[priority];
+
+    flow.lastTag = tag;
+    flow.tags.push_back(tag);
+    flow.jobs.insert(std::move(job));
+}
+
+std::shared_ptr<OcrJob> OcrWorkerPool::popLocked() {
+    // The flow whose oldest tag is smallest goes next. Only flows with
+    // queued jobs exist, and there are a handful of those at most.
+    auto next = flows_.begin();
+    for (auto it = flows_.begin(); it != flows_.end(); ++it) {
+        if (it->second.tags.front() < next->second.tags.front()) next = it;
+    }
+
+    Flow& flow = next->second;
+    virtualTime_ = flow.tags.front();
+    flow.tags.pop_front();
+
+    // Within the flow, the earliest deadline runs first
+    std::shared_ptr<OcrJob> job = *flow.jobs.begin();
+    flow.jobs.erase(flow.jobs.begin());
+    if (flow.jobs.empty()) {
+        flows_.erase(next);
+    }
+
+    noteStartedLocked(*job);
+    return job;
+}
+
+void OcrWorkerPool::noteStartedLocked(OcrJob& job) {
+    job.started = true;
+    --queued_;
+    if (job.regionWork) --queuedRegions_;
+    queuedMs_ = std::max(0.0, queuedMs_ - job.estimatedMs);
+
+    ClassCounters& counters = classCounters_[static_cast<int>(job.jobClass.priority)];
+    const double waitMs = std::chrono::duration<double, std::milli>(
+        CancellationToken::Clock::now() - job.enqueuedAt).count();
+    --counters.queued;
+    counters.avgWaitMs = (counters.started == 0)
+        ? waitMs
+        : SERVICE_TIME_ALPHA * waitMs + (1.0 - SERVICE_TIME_ALPHA) * counters.avgWaitMs;
+    ++counters.started;
+}
+
+std::chrono::milliseconds OcrWorkerPool::retryAfterLocked() const {
+    // Roughly how long until the current backlog has drained
+    const double ms = queuedMs_ / static_cast<double>(workerCount());
+    return std::chrono::milliseconds(std::clamp<long long>(
+        static_cast<long long>(ms), 100, 30000));
+}
+
+double OcrWorkerPool::estimateMsLocked(std::size_t imageBytes) const {
+    return msPerByte_ * static_cast<double>(imageBytes);
+}
+
+void OcrWorkerPool::recordServiceTime(std::size_t imageBytes, double elapsedMs) {
+    if (imageBytes == 0) return;
+    const double sample = elapsedMs / static_cast<double>(imageBytes);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    msPerByte_ = (msPerByte_ == 0.0)
+        ? sample
+        : SERVICE_TIME_ALPHA * sample + (1.0 - SERVICE_TIME_ALPHA) * msPerByte_;
 }
 
 void OcrWorkerPool::workerLoop(int workerIndex) {
+    const std::size_t index = static_cast<std::size_t>(workerIndex);
+
     while (true) {
         std::shared_ptr<OcrJob> job;
 
         {
             std::unique_lock<std::mutex> lock(mutex_);
-            cv_.wait(lock, [this] {
-                return stopping_ || !queue_.empty();
+            cv_.wait(lock, [this, index] {
+                return stopping_ || queued_ > 0 || index >= activeWorkers_;
                 });
 
-            if (stopping_ && queue_.empty()) {
+            if (!stopping_ && index >= activeWorkers_) {
+                // Parked. Pass on the wake-up this thread may have taken
+                // from an active worker.
+                if (queued_ > 0) cv_.notify_one();
+                parkCv_.wait(lock, [this, index] {
+                    return stopping_ || index < activeWorkers_;
+                    });
+                continue;
+            }
+
+            if (stopping_ && queued_ == 0) {
                 return; // exit thread
             }
 
-            job = queue_.front();
-            queue_.pop();
+            job = popLocked();
+            roomCv_.notify_one();
+        }
+
+        runJob(workerIndex, job);
+    }
+}
+
+void OcrWorkerPool::runJob(int workerIndex, const std::shared_ptr<OcrJob>& job) {
+    struct ActiveGuard {
+        std::atomic<std::size_t>& active;
+        explicit ActiveGuard(std::atomic<std::size_t>& a) : active(a) { ++active; }
+        ~ActiveGuard() { --active; }
+    } activeGuard(active_);
+
+    if (job->regionWork) {
+        job->regionWork(workerIndex);
+        return;
+    }
+
+    OcrResult result{};
+    std::exception_ptr error;
+    try {
+        // Nobody is waiting for this one any more; skip the OCR
+        if (job->cancel && job->cancel->isCancelled()) {
+            LOG_DEBUG("dropping cancelled job").kv("worker", workerIndex).kv("id", job->id);
+            throw OcrCancelledError("Job cancelled before it started");
         }
 
-        try {
-            std::cout << "[Worker " << workerIndex
-                << "] processing id=" << job->id << "\n";
+        LOG_DEBUG("processing").kv("worker", workerIndex).kv("id", job->id)
+            .kv("priority", priority_name(job->jobClass.priority));
 
-            OcrResult result = run_ocr_on_bytes(job->imageBytes);
-            job->promise.set_value(std::move(result));
+        auto start = std::chrono::steady_clock::now();
+        if (tileMinPixels_ > 0) {
+            if (runTiled(job, result)) {
+                return; // its regions finish it
+            }
         }
-        catch (...) {
-            job->promise.set_exception(std::current_exception());
+        else {
+            result = recognizer_(job->imageBytes, job->cancel.get(), job->settings);
+            result.timings.queueWaitUs = micros_between(job->enqueuedAt, start);
         }
+        recordServiceTime(job->imageBytes.size(),
+            std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - start).count());
+
+        if (cache_) {
+            cache_->insert(job->contentKey, result.text);
+        }
+    }
+    catch (...) {
+        error = std::current_exception();
     }
+
+    finishJob(job, error, std::move(result));
 }
 
+// True if error is the job being cancelled (by its own caller).
+static bool is_cancellation(std::exception_ptr error) {
+    try {
+        std::rethrow_exception(error);
+    }
+    catch (const OcrCancelledError&) {
+        return true;
+    }
+    catch (...) {
+        return false;
+    }
+}
+
+void OcrWorkerPool::recordLatencies(const OcrTimings& timings, bool recognized) {
+    latencies_.total.record(timings.totalUs);
+    if (!recognized) return;
+
+    latencies_.queueWait.record(timings.queueWaitUs);
+    latencies_.decode.record(timings.decodeUs);
+    latencies_.preprocess.record(timings.preprocessUs);
+    if (timings.layoutUs > 0) latencies_.layout.record(timings.layoutUs);
+    latencies_.engineWait.record(timings.engineWaitUs);
+    latencies_.recognition.record(timings.recognitionUs);
+}
+
+void OcrWorkerPool::countOutcome(const OcrJob& job, std::exception_ptr error) {
+    if (!error) {
+        counters_.completed.add();
+        counters_.completedBytes.add(job.sizeBytes);
+    }
+    else if (!is_cancellation(error)) {
+        counters_.failed.add();
+    }
+    else if (job.deadline <= CancellationToken::Clock::now()) {
+        counters_.timedOut.add();
+    }
+    else {
+        counters_.cancelled.add();
+    }
+}
+
+void OcrWorkerPool::finishJob(const std::shared_ptr<OcrJob>& job,
+    std::exception_ptr error, OcrResult result) {
+    std::vector<std::shared_ptr<OcrJob>> followers;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = inFlight_.find(job->contentKey);
+        if (it != inFlight_.end() && it->second == job) {
+            inFlight_.erase(it);
+        }
+        followers.swap(job->followers);
+    }
+
+    if (error && !followers.empty() && is_cancellation(error)) {
+        // Only this job's caller gave up. If a follower still wants the
+        // image, it takes over (with the other followers riding along)
+        // rather than everyone failing.
+        auto live = std::find_if(followers.begin(), followers.end(),
+            [](const std::shared_ptr<OcrJob>& f) {
+                return !(f->cancel && f->cancel->isCancelled());
+            });
+        if (live != followers.end()) {
+            std::shared_ptr<OcrJob> next = *live;
+            followers.erase(live);
+            next->followers = std::move(followers);
+            followers.clear();
+
+            try {
+                std::vector<std::shared_ptr<OcrJob>> retry;
+                retry.push_back(next);
+                admitBatch(std::move(retry), /*waitForRoom*/ false);
+            }
+            catch (...) {
+                // Refused, so next was never queued and its list is ours
+                followers = std::move(next->followers);
+                followers.push_back(next);
+                countOutcome(*job, error);
+                complete_job(*job, error, std::move(result));
+                error = std::current_exception();
+                for (auto& f : followers) {
+                    countOutcome(*f, error);
+                    complete_job(*f, error, OcrResult{});
+                }
+                return;
+            }
+        }
+    }
+
+    // Each caller's total runs from when its own job arrived; followers
+    // share the leader's stages
+    const auto now = CancellationToken::Clock::now();
+    for (auto& f : followers) {
+        OcrResult copy = result;
+        copy.timings.totalUs = micros_between(f->receivedAt, now);
+        if (!error) recordLatencies(copy.timings, /*recognized*/ false);
+        countOutcome(*f, error);
+        complete_job(*f, error, std::move(copy));
+    }
+    result.timings.totalUs = micros_between(job->receivedAt, now);
+    if (!error) recordLatencies(result.timings, /*recognized*/ true);
+    countOutcome(*job, error);
+    complete_job(*job, error, std::move(result));
+}
+
+// A page being recognized as several region jobs. The last region to
+// finish stitches the texts together and completes the page's job.
+struct OcrWorkerPool::TileGroup {
+    std::shared_ptr<OcrJob> page;
+    std::shared_ptr<TiledPage> tiles;
+    // Child of the page's token; cancelled when a region fails so the rest
+    // stop early
+    std::shared_ptr<CancellationToken> cancel;
+    std::chrono::steady_clock::time_point start;
+
+    std::mutex mutex;
+    std::vector<std::string> texts;
+    std::size_t remaining = 0;
+    double workMs = 0.0; // summed over regions, for the service-time estimate
+    OcrTimings timings;  // the page's; regions add their engine stages
+    std::exception_ptr error;
+};
+
+// Decodes and analyses the job's page. Returns false with result filled in
+// if it is read as one region here; true if it was split into region jobs,
+// which complete the job later.
+bool OcrWorkerPool::runTiled(const std::shared_ptr<OcrJob>& job, OcrResult& result) {
+    const auto start = std::chrono::steady_clock::now();
+    const std::size_t maxRegions = workerCount() * TILE_REGIONS_PER_WORKER;
+    auto tiles = TiledPage::analyse(job->imageBytes, job->settings, tileMinPixels_,
+        maxRegions, job->cancel.get());
+
+    OcrTimings timings = tiles->timings();
+    timings.queueWaitUs = micros_between(job->enqueuedAt, start);
+
+    if (tiles->regionCount() < 2) {
+        result.text = tiles->recognizeRegion(0, job->cancel.get(), &timings);
+        result.processingTimeMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start).count();
+        result.timings = timings;
+        return false;
+    }
+
+    auto group = std::make_shared<TileGroup>();
+    group->page = job;
+    group->tiles = tiles;
+    group->cancel = std::make_shared<CancellationToken>(job->cancel, job->deadline);
+    group->start = start;
+    group->texts.resize(tiles->regionCount());
+    group->remaining = tiles->regionCount();
+    group->timings = timings;
+    // Layout analysis is part of the page's work
+    group->workMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+
+    // Each region is costed at its share of the page, so the page as a
+    // whole is charged to its flow the same as an untiled one
+    const std::size_t shareBytes = std::max<std::size_t>(
+        job->sizeBytes / tiles->regionCount(), 1);
+
+    std::vector<std::shared_ptr<OcrJob>> regions;
+    regions.reserve(tiles->regionCount());
+    for (std::size_t i = 0; i < tiles->regionCount(); ++i) {
+        auto region = make_job(job->id, std::string(), job->settings, group->cancel,
+            job->jobClass);
+        region->sizeBytes = shareBytes;
+        region->regionWork = [this, group, i](int workerIndex) {
+            runRegion(workerIndex, group, i);
+        };
+        regions.push_back(std::move(region));
+    }
+
+    // Already admitted as part of the page, so no capacity or deadline check
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const double shareMs = estimateMsLocked(shareBytes);
+        for (auto& region : regions) region->estimatedMs = shareMs;
+        queueLocked(regions);
+    }
+    dispatch(std::move(regions));
+    return true;
+}
+
+void OcrWorkerPool::runRegion(int workerIndex, const std::shared_ptr<TileGroup>& group,
+    std::size_t index) {
+    std::string text;
+    OcrTimings timings;
+    std::exception_ptr error;
+    const auto start = std::chrono::steady_clock::now();
+    try {
+        LOG_DEBUG("processing region").kv("worker", workerIndex).kv("id", group->page->id)
+            .kv("region", index + 1).kv("of", group->texts.size());
+        text = group->tiles->recognizeRegion(index, group->cancel.get(), &timings);
+    }
+    catch (...) {
+        error = std::current_exception();
+    }
+    const double elapsedMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+
+    bool last = false;
+    {
+        std::lock_guard<std::mutex> lock(group->mutex);
+        // The first failure is the page's; regions cancelled because of it
+        // come later
+        if (error && !group->error) group->error = error;
+        group->texts[index] = std::move(text);
+        group->workMs += elapsedMs;
+        group->timings.engineWaitUs += timings.engineWaitUs;
+        group->timings.recognitionUs += timings.recognitionUs;
+        last = --group->remaining == 0;
+    }
+    if (error) group->cancel->cancel();
+    if (!last) return;
+
+    const std::shared_ptr<OcrJob>& page = group->page;
+    OcrResult result{};
+    if (!group->error) {
+        result.text = TiledPage::stitch(group->texts);
+        result.processingTimeMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - group->start).count();
+        result.timings = group->timings;
+        recordServiceTime(page->sizeBytes, group->workMs);
+
+        if (cache_) {
+            cache_->insert(page->contentKey, result.text);
+        }
+    }
+    finishJob(page, group->error, std::move(result));
+}
@@ -1,35 +1,352 @@
 #pragma once
 
+#include "CancellationToken.h"
+#include "LatencyHistogram.h"
+#include "Metrics.h"
 #include "OcrProcessor.h"
+#include "ResultCache.h"
+#include "WorkStealingScheduler.h"
 
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
 #include <future>
+#include <map>
+#include <unordered_map>
+#include <memory>
 #include <mutex>
-#include <queue>
+#include <set>
+#include <stdexcept>
+#include <string>
 #include <thread>
+#include <utility>
 #include <vector>
 
+// Completion callback for callers that must not block on a future
+// (the async server). Runs on the worker thread that finished the job;
+// error is null on success.
+using OcrCallback = std::function<void(std::exception_ptr error, OcrResult result)>;
+
+// Per-task completion for enqueueBatch(); index is the task's position in
+// the batch.
+using OcrBatchCallback = std::function<void(std::size_t index, std::exception_ptr error, OcrResult result)>;
+
+// Recognizes one whole image; run_ocr_on_bytes() unless replaced with
+// OcrWorkerPool::setRecognizer().
+using OcrRecognizer = std::function<OcrResult(const std::string& imageBytes,
+    const CancellationToken* cancel, const OcrSettings& settings)>;
+
+// Runs first on each worker thread, e.g. to pin it to a core; index is
+// 0 .. numThreads - 1.
+using WorkerStartHook = std::function<void(std::size_t workerIndex)>;
+
+struct OcrTask {
+    int id;
+    std::string imageBytes;
+    OcrSettings settings;
+};
+
+// Scheduling class of a job. Values match the proto's Priority enum.
+enum class JobPriority { Normal = 0, Interactive = 1, Bulk = 2 };
+constexpr int JOB_PRIORITY_COUNT = 3;
+
+const char* priority_name(JobPriority priority);
+
+// Who a job is for: its priority class, and the client (tenant) it is
+// charged to when the workers are shared out.
+struct JobClass {
+    JobPriority priority = JobPriority::Normal;
+    std::string client;
+};
+
+// Queue depth and waiting time of one priority class.
+struct PoolClassStats {
+    JobPriority priority = JobPriority::Normal;
+    std::size_t queued = 0;
+    std::uint64_t started = 0;
+    double avgWaitMs = 0.0;    // recent average time from enqueue to start
+    double oldestWaitMs = 0.0; // age of the longest-waiting queued job
+};
+
 struct OcrJob {
     int id;
     std::string imageBytes;
+    OcrSettings settings;
     std::promise<OcrResult> promise;
+    OcrCallback onDone; // if set, used instead of promise
+    CancelTokenPtr cancel; // optional; cancelled jobs are dropped or aborted
+    JobClass jobClass;
+    CancellationToken::Clock::time_point receivedAt; // handed to the pool
+    CancellationToken::Clock::time_point enqueuedAt; // taken into the queue
+    ResultCacheKey contentKey; // image hash + OCR settings, set on enqueue
+
+    // Jobs for the same image that arrived while this one was queued or
+    // running; they get its outcome instead of running themselves.
+    // Guarded by the pool's mutex, as is started.
+    std::vector<std::shared_ptr<OcrJob>> followers;
+    bool started = false; // taken off the queue by a worker
+
+    // Scheduling within a client's share: earliest deadline first, FIFO
+    // among equal deadlines. Jobs without a token have no deadline and run
+    // after those that do.
+    CancellationToken::Clock::time_point deadline = CancellationToken::Clock::time_point::max();
+    std::uint64_t seq = 0;
+    double estimatedMs = 0.0;
+    std::size_t sizeBytes = 0; // what the job is costed at when scheduled
+
+    // Set on the internal jobs a tiled page is split into (see
+    // setTileMinPixels): runs one region of a page instead of an image.
+    std::function<void(int workerIndex)> regionWork;
+};
+
+// Thrown by enqueue()/enqueueBatch() when the queue cannot take the work.
+// retryAfter is a rough estimate of when the current backlog will have
+// drained.
+class PoolOverloadedError : public std::runtime_error {
+public:
+    PoolOverloadedError(const std::string& what, std::chrono::milliseconds retryAfter)
+        : std::runtime_error(what), retryAfter_(retryAfter) {
+    }
+
+    std::chrono::milliseconds retryAfter() const { return retryAfter_; }
+
+private:
+    std::chrono::milliseconds retryAfter_;
+};
+
+// Thrown by enqueueBatch() when the batch has more distinct images than the
+// queue can ever hold, so waiting and retrying would never help.
+class BatchTooLargeError : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+// Thrown by enqueue()/enqueueBatch() when the work cannot finish before its deadline even if
+// it started right away behind the work already queued ahead of it.
+class DeadlineUnreachableError : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+// Latency of each OcrTimings stage over the jobs the pool has completed
+// successfully, in microseconds. Stage histograms count images that were
+// recognized; total also counts cache hits and coalesced jobs.
+struct StageLatencies {
+    LatencyHistogram queueWait;
+    LatencyHistogram decode;
+    LatencyHistogram preprocess;
+    LatencyHistogram layout; // tiled pages only
+    LatencyHistogram engineWait;
+    LatencyHistogram recognition;
+    LatencyHistogram total;
 };
 
+// What became of the images handed to the pool. An image counts once, when
+// its caller gets an outcome, however it was served (recognized, cached or
+// coalesced).
+struct PoolCounters {
+    Counter completed;
+    Counter completedBytes;   // image bytes of completed images
+    Counter failed;
+    Counter cancelled;        // by the caller, before the deadline
+    Counter timedOut;         // cancelled by reaching the deadline
+    Counter rejectedQueueFull;
+    Counter rejectedDeadline; // refused as unable to meet the deadline
+    Counter rejectedTooLarge; // batches larger than the whole queue
+};
+
+// How queued jobs are handed to workers.
+//   EarliestDeadlineFirst: one shared queue. Each (priority, client) pair
+//     is a flow; flows share the workers by weighted fair queuing, with
+//     interactive work weighted well above normal and bulk work, and each
+//     flow runs its own jobs in deadline order.
+//   WorkStealing: per-worker deques (see WorkStealingScheduler); jobs run
+//     roughly in arrival order and admission treats everything queued as
+//     ahead of a new job; priority classes are only reported, not enforced.
+//     For many small jobs or many workers, where the shared queue's lock
+//     becomes the bottleneck.
+enum class PoolScheduling { EarliestDeadlineFirst, WorkStealing };
+
 class OcrWorkerPool {
 public:
-    OcrWorkerPool(std::size_t numThreads, std::size_t maxQueueSize);
+    // workerNodes optionally gives each worker's NUMA node. In WorkStealing
+    // mode jobs then stay on the node of the thread that enqueued them
+    // unless another node runs out of work (see WorkStealingScheduler);
+    // EarliestDeadlineFirst's one queue ignores it.
+    OcrWorkerPool(std::size_t numThreads, std::size_t maxQueueSize,
+        PoolScheduling scheduling = PoolScheduling::EarliestDeadlineFirst,
+        WorkerStartHook onWorkerStart = nullptr, std::vector<int> workerNodes = {});
     ~OcrWorkerPool();
 
-    std::future<OcrResult> enqueue(int id, const std::string& imageBytes);
+    // Single-job enqueue; throws PoolOverloadedError when the queue is full.
+    // Both overloads take the bytes by value: callers that own the buffer
+    // (a mutable request, a reassembled upload) should std::move it in so
+    // the image is never copied on its way to the decoder.
+    // A cancelled job still completes (with OcrCancelledError) so callers
+    // waiting on its future or callback are always released.
+    std::future<OcrResult> enqueue(int id, std::string imageBytes,
+        CancelTokenPtr cancel = nullptr, const JobClass& jobClass = JobClass(),
+        const OcrSettings& settings = OcrSettings());
+    void enqueue(int id, std::string imageBytes, OcrCallback onDone,
+        CancelTokenPtr cancel = nullptr, const JobClass& jobClass = JobClass(),
+        const OcrSettings& settings = OcrSettings());
+
+    // Like the callback enqueue(), but blocks while the queue is full rather
+    // than throwing PoolOverloadedError. Throws OcrCancelledError if cancel
+    // fires while waiting. For producers that can simply be slowed down.
+    void enqueueWhenRoom(int id, std::string imageBytes, OcrCallback onDone,
+        CancelTokenPtr cancel = nullptr, const JobClass& jobClass = JobClass(),
+        const OcrSettings& settings = OcrSettings());
+
+    // Whole-batch admission: either every task is queued or none is (the
+    // call throws and no callback runs), so a refused batch leaves no
+    // orphaned work behind. Tasks share one token and therefore a deadline.
+    // A batch with more distinct images than maxQueueSize is refused with
+    // BatchTooLargeError rather than PoolOverloadedError, since it would
+    // never fit.
+    std::vector<std::future<OcrResult>> enqueueBatch(std::vector<OcrTask> tasks,
+        CancelTokenPtr cancel = nullptr, const JobClass& jobClass = JobClass());
+    void enqueueBatch(std::vector<OcrTask> tasks, const OcrBatchCallback& onDone,
+        CancelTokenPtr cancel = nullptr, const JobClass& jobClass = JobClass());
+
+    // Workers currently taking jobs, and the threads there are for them.
+    std::size_t workerCount() const;
+    std::size_t maxWorkers() const;
+
+    // Elastic sizing: only workers 0 .. count - 1 (clamped to
+    // 1 .. maxWorkers()) take jobs; the others finish what they are running
+    // and park until activated again. Admission and tiling follow the
+    // active count. Safe to call at any time, from any thread.
+    void setActiveWorkers(std::size_t count);
+
+    // Jobs that were attached to an identical queued or running job instead
+    // of being run again.
+    std::uint64_t coalescedJobs() const;
+
+    // Optional. Jobs whose image was recognized before complete at enqueue
+    // time, on the caller's thread, without taking a queue slot; new
+    // results are added as jobs finish. Call before the first enqueue.
+    void attachCache(ResultCache& cache) {
+        cache_ = &cache;
+        hashKey_ = cache.hashKey();
+    }
+
+    // Tile-parallel recognition. Images of at least minPixels are split into
+    // layout blocks or bands after decoding (see TiledPage), each recognized
+    // as a separate job, so one large page is read by several workers at
+    // once. Region jobs inherit the page's class and deadline; they show in
+    // queuedJobs() but do not take slots from the queue limit, since their
+    // page was admitted already. 0 (the default) disables it.
+    void setTileMinPixels(std::size_t minPixels) { tileMinPixels_ = minPixels; }
+
+    // Replaces the recognition of untiled images, e.g. with a stub so the
+    // pool's own overhead can be measured. Call before the first enqueue.
+    void setRecognizer(OcrRecognizer recognizer) { recognizer_ = std::move(recognizer); }
+
+    // One entry per priority class, in JobPriority order.
+    std::vector<PoolClassStats> classStats() const;
+
+    // Live histograms, updated as jobs complete; take snapshots to read.
+    const StageLatencies& stageLatencies() const { return latencies_; }
+    const PoolCounters& counters() const { return counters_; }
+
+    // Jobs (including tiled-page regions) queued, and being run right now.
+    std::size_t queuedJobs() const;
+    std::size_t activeJobs() const { return active_.load(std::memory_order_relaxed); }
+
+    const ResultCache* cache() const { return cache_; }
 
 private:
+    struct EarliestDeadlineFirst {
+        bool operator()(const std::shared_ptr<OcrJob>& a,
+            const std::shared_ptr<OcrJob>& b) const {
+            if (a->deadline != b->deadline) return a->deadline < b->deadline;
+            return a->seq < b->seq;
+        }
+    };
+
+    void push(std::shared_ptr<OcrJob> job);
+    void pushBatch(std::vector<std::shared_ptr<OcrJob>> jobs, bool waitForRoom);
+    void admitBatch(std::vector<std::shared_ptr<OcrJob>> jobs, bool waitForRoom);
+    void queueLocked(const std::vector<std::shared_ptr<OcrJob>>& jobs);
+    void dispatch(std::vector<std::shared_ptr<OcrJob>> jobs);
+    std::chrono::milliseconds retryAfterLocked() const;
+    void insertLocked(std::shared_ptr<OcrJob> job);
+    std::shared_ptr<OcrJob> popLocked();
+    void noteStartedLocked(OcrJob& job);
     void workerLoop(int workerIndex);
+    void runJob(int workerIndex, const std::shared_ptr<OcrJob>& job);
+    void finishJob(const std::shared_ptr<OcrJob>& job, std::exception_ptr error,
+        OcrResult result);
+    void recordLatencies(const OcrTimings& timings, bool recognized);
+    void countOutcome(const OcrJob& job, std::exception_ptr error);
+
+    struct TileGroup;
+    bool runTiled(const std::shared_ptr<OcrJob>& job, OcrResult& result);
+    void runRegion(int workerIndex, const std::shared_ptr<TileGroup>& group, std::size_t index);
+
+    // Expected run time of a job of this size, from recent throughput.
+    // Reads msPerByte_, so mutex_ must be held.
+    double estimateMsLocked(std::size_t imageBytes) const;
+    void recordServiceTime(std::size_t imageBytes, double elapsedMs);
+
+    // Fair-queuing flow: the queued jobs of one (priority, client) pair and
+    // the virtual finish tags they were given on arrival.
+    struct Flow {
+        std::set<std::shared_ptr<OcrJob>, EarliestDeadlineFirst> jobs;
+        std::deque<double> tags; // oldest first
+        double lastTag = 0.0;
+    };
+
+    struct ClassCounters {
+        std::size_t queued = 0;
+        std::uint64_t started = 0;
+        double avgWaitMs = 0.0;
+    };
 
     std::vector<std::thread> workers_;
-    std::queue<std::shared_ptr<OcrJob>> queue_;
-    std::mutex mutex_;
+    std::map<std::pair<int, std::string>, Flow> flows_; // by (priority, client)
+    double virtualTime_ = 0.0; // tag of the job started last
+
+    // Single flight: the job queued or running for each image, in either
+    // scheduling mode; the most urgent one if there are several.
+    std::unordered_map<ResultCacheKey, std::shared_ptr<OcrJob>, ResultCacheKeyHash> inFlight_;
+    std::uint64_t coalesced_ = 0;
+
+    ResultCache* cache_ = nullptr;
+    // Keys contentKey; the cache's own secret once one is attached
+    ContentHashKey hashKey_ = random_content_hash_key();
+    std::size_t tileMinPixels_ = 0;
+    OcrRecognizer recognizer_ = run_ocr_on_bytes;
+    // Lock-free, not guarded by mutex_
+    StageLatencies latencies_;
+    PoolCounters counters_;
+    std::atomic<std::size_t> active_{ 0 };
+
+    // Set in WorkStealing mode instead of workers_/flows_.
+    std::unique_ptr<WorkStealingScheduler> stealing_;
+
+    mutable std::mutex mutex_;
     std::condition_variable cv_;
+    std::condition_variable roomCv_; // signalled when a job leaves the queue
+    std::condition_variable parkCv_; // workers idled by setActiveWorkers()
+    // Written under mutex_, read without it; EarliestDeadlineFirst mode only
+    std::atomic<std::size_t> activeWorkers_{ 0 };
     bool stopping_ = false;
+    std::uint64_t nextSeq_ = 0;
+
+    // Guarded by mutex_. Zero until the first job completes, which disables
+    // admission checks until there is something to go on.
+    double msPerByte_ = 0.0;
+    double queuedMs_ = 0.0; // sum of estimatedMs over queued jobs
+    std::size_t queued_ = 0; // queued and not yet started, in either mode
+    std::size_t queuedRegions_ = 0; // of queued_, tiled-page regions (not admitted)
+    std::array<ClassCounters, JOB_PRIORITY_COUNT> classCounters_;
 
     std::size_t maxQueueSize_ = 0;
 };
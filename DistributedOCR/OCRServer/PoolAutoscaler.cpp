@@ -0,0 +1,119 @@
+#include "PoolAutoscaler.h"
+
+#include "CpuTopology.h"
+#include "LatencyHistogram.h"
+#include "Logger.h"
+#include "OcrProcessor.h"
+
+#include <algorithm>
+
+// How often the busy-worker count is sampled between decisions
+static const auto SAMPLE_INTERVAL = std::chrono::milliseconds(100);
+
+// Shrinking needs the queue well under target and the workers that would
+// remain not too busy, so the next burst does not immediately grow it back.
+static const double SHRINK_WAIT_FRACTION = 0.25;
+static const double SHRINK_MAX_UTILISATION = 0.7;
+
+std::size_t AutoscalePolicy::next(std::size_t current, const AutoscaleSample& sample) {
+    const std::size_t minWorkers = options_.minWorkers;
+    const std::size_t maxWorkers = std::max(options_.minWorkers, options_.maxWorkers);
+
+    const bool over = sample.queueWaitMs > options_.targetQueueWaitMs;
+    const double busyWorkers = sample.utilisation * static_cast<double>(current);
+    const bool quiet = sample.queueWaitMs < SHRINK_WAIT_FRACTION * options_.targetQueueWaitMs
+        && current > 1
+        && busyWorkers < SHRINK_MAX_UTILISATION * static_cast<double>(current - 1);
+
+    overStreak_ = over ? overStreak_ + 1 : 0;
+    quietStreak_ = quiet ? quietStreak_ + 1 : 0;
+
+    std::size_t next = current;
+    if (overStreak_ >= options_.growAfter && sample.cpu < options_.maxCpuForGrowth) {
+        next = current + std::max<std::size_t>(1, current / 4);
+    }
+    else if (quietStreak_ >= options_.shrinkAfter) {
+        next = current - 1;
+    }
+    next = std::clamp(next, minWorkers, maxWorkers);
+
+    if (next != current) {
+        overStreak_ = 0;
+        quietStreak_ = 0;
+    }
+    return next;
+}
+
+static AutoscaleOptions clamp_to_pool(AutoscaleOptions options, const OcrWorkerPool& pool) {
+    const std::size_t threads = pool.maxWorkers();
+    if (options.maxWorkers == 0 || options.maxWorkers > threads) options.maxWorkers = threads;
+    options.minWorkers = std::clamp<std::size_t>(options.minWorkers, 1, options.maxWorkers);
+    return options;
+}
+
+PoolAutoscaler::PoolAutoscaler(OcrWorkerPool& pool, AutoscaleOptions options)
+    : pool_(pool), options_(clamp_to_pool(options, pool)), policy_(options_) {
+    pool_.setActiveWorkers(options_.minWorkers);
+    LOG_INFO("elastic worker pool").kv("min_workers", options_.minWorkers)
+        .kv("max_workers", options_.maxWorkers)
+        .kv("target_queue_wait_ms", options_.targetQueueWaitMs);
+    thread_ = std::thread(&PoolAutoscaler::run, this);
+}
+
+void PoolAutoscaler::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    cv_.notify_all();
+    if (thread_.joinable()) thread_.join();
+}
+
+void PoolAutoscaler::run() {
+    HistogramSnapshot lastWaits = pool_.stageLatencies().queueWait.snapshot();
+    CpuTimes lastCpu = read_cpu_times();
+    double busySum = 0.0;
+    int samples = 0;
+    auto nextDecision = std::chrono::steady_clock::now() + options_.interval;
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!cv_.wait_for(lock, SAMPLE_INTERVAL, [this] { return stopping_; })) {
+        const std::size_t current = pool_.workerCount();
+        busySum += std::min(1.0, static_cast<double>(pool_.activeJobs()) / static_cast<double>(current));
+        ++samples;
+
+        const auto now = std::chrono::steady_clock::now();
+        if (now < nextDecision) continue;
+        nextDecision = now + options_.interval;
+
+        AutoscaleSample sample;
+        const HistogramSnapshot waits = pool_.stageLatencies().queueWait.snapshot();
+        sample.queueWaitMs = waits.since(lastWaits).percentile(0.95) / 1000.0;
+        lastWaits = waits;
+        // A queue that is stuck starts nothing, so its jobs' age counts too
+        for (const auto& s : pool_.classStats()) {
+            sample.queueWaitMs = std::max(sample.queueWaitMs, s.oldestWaitMs);
+        }
+
+        sample.utilisation = busySum / samples;
+        busySum = 0.0;
+        samples = 0;
+
+        const CpuTimes cpu = read_cpu_times();
+        sample.cpu = cpu_utilisation(lastCpu, cpu);
+        lastCpu = cpu;
+
+        const std::size_t next = policy_.next(current, sample);
+        if (next != current) {
+            pool_.setActiveWorkers(next);
+            LOG_INFO("resizing worker pool").kv("from", current).kv("to", next)
+                .kv("queue_wait_ms", static_cast<long long>(sample.queueWaitMs))
+                .kv("utilisation_pct", static_cast<int>(100 * sample.utilisation))
+                .kv("cpu_pct", static_cast<int>(100 * sample.cpu));
+        }
+
+        // Engines follow the workers down, including ones that were busy
+        // when the pool shrank; they are loaded again when needed
+        if (next < pool_.maxWorkers()) trim_tess_engines(next);
+    }
+}
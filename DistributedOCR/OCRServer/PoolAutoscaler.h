@@ -0,0 +1,72 @@
+#pragma once
+
+#include "OcrWorkerPool.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+
+struct AutoscaleOptions {
+    std::size_t minWorkers = 1;
+    std::size_t maxWorkers = 0;       // 0: all of the pool's threads
+    double targetQueueWaitMs = 500.0; // p95 wait from enqueue to start to stay under
+    double maxCpuForGrowth = 0.9;     // machine busier than this: more workers cannot help
+    std::chrono::milliseconds interval{ 2000 }; // between sizing decisions
+    int growAfter = 2;    // decisions in a row over target before growing
+    int shrinkAfter = 15; // quiet decisions in a row before shrinking
+};
+
+// What a sizing decision looks at, measured over the last interval.
+struct AutoscaleSample {
+    double queueWaitMs = 0.0; // p95 of jobs started, or the oldest queued job's wait if longer
+    double utilisation = 0.0; // average fraction of the active workers running a job
+    double cpu = 0.0;         // machine-wide CPU utilisation, 0..1
+};
+
+// The sizing rule, kept apart from the measuring thread:
+//   - grow by a quarter (at least one worker) once queue wait has been over
+//     target growAfter decisions in a row, unless the machine's CPU is
+//     already used up;
+//   - shrink by one once queue wait has stayed under a quarter of the
+//     target, with the remaining workers less than 70% busy, shrinkAfter
+//     decisions in a row.
+// Anything in between breaks both streaks, as does every resize, so the
+// size cannot flap: it grows fast under backlog and gives back slowly.
+class AutoscalePolicy {
+public:
+    explicit AutoscalePolicy(const AutoscaleOptions& options) : options_(options) {}
+
+    // Worker count for the next interval.
+    std::size_t next(std::size_t current, const AutoscaleSample& sample);
+
+private:
+    AutoscaleOptions options_;
+    int overStreak_ = 0;
+    int quietStreak_ = 0;
+};
+
+// Elastic mode for an OcrWorkerPool: samples it every 100 ms and, every
+// interval, resizes it with OcrWorkerPool::setActiveWorkers() between
+// minWorkers and maxWorkers by AutoscalePolicy. Idle Tesseract engines
+// beyond the worker count are freed as it shrinks and loaded again on
+// demand as it grows. Starts the pool at minWorkers; runs until stop().
+class PoolAutoscaler {
+public:
+    PoolAutoscaler(OcrWorkerPool& pool, AutoscaleOptions options);
+    ~PoolAutoscaler() { stop(); }
+
+    void stop();
+
+private:
+    void run();
+
+    OcrWorkerPool& pool_;
+    AutoscaleOptions options_;
+    AutoscalePolicy policy_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stopping_ = false;
+    std::thread thread_;
+};
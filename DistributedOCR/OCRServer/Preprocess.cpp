@@ -0,0 +1,304 @@
+#include "Preprocess.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <string>
+
+// SSE2 is part of x86-64, so the vector kernels are always used there; other
+// targets get the scalar loops.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define OCR_PREPROCESS_SSE2 1
+#include <emmintrin.h>
+#endif
+
+// Sauvola's dynamic range of the standard deviation, for 8-bit images.
+static const float SAUVOLA_R = 128.0f;
+
+// Sauvola on one row: out[x] = 255 if gray[x] > mean * (1 + k * (sd / R - 1)),
+// else 0, where sd = sqrt(sqmean - mean^2).
+static void sauvola_row(const std::uint8_t* gray, const float* mean, const float* sqmean,
+    std::uint8_t* out, int width, float k) {
+    int x = 0;
+
+#ifdef OCR_PREPROCESS_SSE2
+    const __m128 vk = _mm_set1_ps(k);
+    const __m128 vkOverR = _mm_set1_ps(k / SAUVOLA_R);
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128i zeroi = _mm_setzero_si128();
+
+    // 16 pixels per step: widen the bytes to four float vectors, compare
+    // each against its threshold, then narrow the four masks back to bytes
+    for (; x + 16 <= width; x += 16) {
+        const __m128i g8 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(gray + x));
+        const __m128i g16lo = _mm_unpacklo_epi8(g8, zeroi);
+        const __m128i g16hi = _mm_unpackhi_epi8(g8, zeroi);
+        const __m128i g32[4] = {
+            _mm_unpacklo_epi16(g16lo, zeroi), _mm_unpackhi_epi16(g16lo, zeroi),
+            _mm_unpacklo_epi16(g16hi, zeroi), _mm_unpackhi_epi16(g16hi, zeroi),
+        };
+
+        __m128i mask[4];
+        for (int i = 0; i < 4; ++i) {
+            const __m128 m = _mm_loadu_ps(mean + x + 4 * i);
+            const __m128 sq = _mm_loadu_ps(sqmean + x + 4 * i);
+            const __m128 sd = _mm_sqrt_ps(_mm_max_ps(_mm_sub_ps(sq, _mm_mul_ps(m, m)), zero));
+            // mean * (1 - k + k * sd / R)
+            const __m128 t = _mm_mul_ps(m, _mm_add_ps(_mm_sub_ps(one, vk), _mm_mul_ps(vkOverR, sd)));
+            mask[i] = _mm_castps_si128(_mm_cmpgt_ps(_mm_cvtepi32_ps(g32[i]), t));
+        }
+
+        // All-ones lanes stay -1 through the signed saturating packs: 0xFF
+        const __m128i m16lo = _mm_packs_epi32(mask[0], mask[1]);
+        const __m128i m16hi = _mm_packs_epi32(mask[2], mask[3]);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + x), _mm_packs_epi16(m16lo, m16hi));
+    }
+#endif
+
+    for (; x < width; ++x) {
+        const float m = mean[x];
+        const float sd = std::sqrt(std::max(sqmean[x] - m * m, 0.0f));
+        const float t = m * (1.0f - k + k / SAUVOLA_R * sd);
+        out[x] = (static_cast<float>(gray[x]) > t) ? 255 : 0;
+    }
+}
+
+cv::Mat sauvola_binarize(const cv::Mat& gray, int window, double k) {
+    window = std::max(3, window | 1);
+
+    // Local mean and mean of squares over the window. Box filters cost the
+    // same whatever the window size, and OpenCV vectorizes them.
+    cv::Mat mean, sqmean;
+    cv::boxFilter(gray, mean, CV_32F, cv::Size(window, window), cv::Point(-1, -1),
+        true, cv::BORDER_REPLICATE);
+    cv::sqrBoxFilter(gray, sqmean, CV_32F, cv::Size(window, window), cv::Point(-1, -1),
+        true, cv::BORDER_REPLICATE);
+
+    cv::Mat binary(gray.rows, gray.cols, CV_8UC1);
+    for (int y = 0; y < gray.rows; ++y) {
+        sauvola_row(gray.ptr<std::uint8_t>(y), mean.ptr<float>(y), sqmean.ptr<float>(y),
+            binary.ptr<std::uint8_t>(y), gray.cols, static_cast<float>(k));
+    }
+    return binary;
+}
+
+// Sum of squared row counts of points projected at angle: largest when the
+// text lines run along the projection, so each row is all ink or all gap.
+static double projection_score(const std::vector<cv::Point>& points, double degrees,
+    int height, int width, std::vector<int>& rows) {
+    const double radians = degrees * 3.14159265358979323846 / 180.0;
+    const double sinA = std::sin(radians);
+    const double cosA = std::cos(radians);
+
+    // Rotated y ranges over [-width, width + height]
+    rows.assign(static_cast<std::size_t>(height + 2 * width + 1), 0);
+    for (const auto& p : points) {
+        const int r = static_cast<int>(std::lround(p.y * cosA - p.x * sinA)) + width;
+        ++rows[static_cast<std::size_t>(r)];
+    }
+
+    double score = 0.0;
+    for (int count : rows) score += static_cast<double>(count) * count;
+    return score;
+}
+
+double estimate_skew(const cv::Mat& binary, double maxDegrees) {
+    // The angle only needs a sketch of the page: at most this many pixels
+    // across, and this many ink pixels sampled
+    const int MAX_SIDE = 1000;
+    const std::size_t MAX_POINTS = 40000;
+
+    cv::Mat small = binary;
+    const int side = std::max(binary.cols, binary.rows);
+    if (side > MAX_SIDE) {
+        const double scale = static_cast<double>(MAX_SIDE) / side;
+        cv::resize(binary, small, cv::Size(std::max(1, static_cast<int>(binary.cols * scale)),
+            std::max(1, static_cast<int>(binary.rows * scale))), 0, 0, cv::INTER_AREA);
+    }
+
+    // Ink is black; findNonZero wants it non-zero
+    cv::Mat ink;
+    cv::threshold(small, ink, 128, 255, cv::THRESH_BINARY_INV);
+    std::vector<cv::Point> points;
+    cv::findNonZero(ink, points);
+    if (points.size() < 100) return 0.0; // (nearly) blank page
+
+    if (points.size() > MAX_POINTS) {
+        const std::size_t stride = points.size() / MAX_POINTS + 1;
+        std::size_t kept = 0;
+        for (std::size_t i = 0; i < points.size(); i += stride) points[kept++] = points[i];
+        points.resize(kept);
+    }
+
+    // Coarse sweep, then a finer one around the best coarse angle
+    std::vector<int> rows;
+    auto best_in = [&](double from, double to, double step) {
+        double best = 0.0;
+        double bestScore = -1.0;
+        for (double a = from; a <= to + 1e-9; a += step) {
+            const double score = projection_score(points, a, small.rows, small.cols, rows);
+            if (score > bestScore) {
+                bestScore = score;
+                best = a;
+            }
+        }
+        return best;
+    };
+    const double coarse = best_in(-maxDegrees, maxDegrees, 0.5);
+    return best_in(coarse - 0.5, coarse + 0.5, 0.05);
+}
+
+static cv::Mat rotate_page(const cv::Mat& binary, double degrees) {
+    const cv::Point2f center(binary.cols / 2.0f, binary.rows / 2.0f);
+    cv::Mat rotation = cv::getRotationMatrix2D(center, degrees, 1.0);
+
+    // Nearest neighbour keeps the page binary; corners fill with paper
+    cv::Mat rotated;
+    cv::warpAffine(binary, rotated, rotation, binary.size(), cv::INTER_NEAREST,
+        cv::BORDER_CONSTANT, cv::Scalar(255));
+    return rotated;
+}
+
+// First index from the start of counts (ink per row or column, out of
+// length) that belongs to the page content: past any dark edge (mostly
+// ink) and then past blank lines.
+static int content_start(const cv::Mat& counts, int length) {
+    const int n = counts.rows * counts.cols;
+    const int* c = counts.ptr<int>(0);
+    const int blank = std::max(1, length / 500); // tolerates specks
+
+    int i = 0;
+    while (i < n && c[i] * 2 > length) ++i;
+    while (i < n && c[i] <= blank) ++i;
+    return i;
+}
+
+static int content_end(const cv::Mat& counts, int length) {
+    const int n = counts.rows * counts.cols;
+    const int* c = counts.ptr<int>(0);
+    const int blank = std::max(1, length / 500);
+
+    int i = n;
+    while (i > 0 && c[i - 1] * 2 > length) --i;
+    while (i > 0 && c[i - 1] <= blank) --i;
+    return i;
+}
+
+static cv::Mat crop_borders(const cv::Mat& binary) {
+    // Tesseract reads text touching the image edge poorly; keep a margin
+    const int PADDING = 10;
+
+    // Ink per row and per column: the page is 0/255, so count the dark
+    cv::Mat ink;
+    cv::threshold(binary, ink, 128, 1, cv::THRESH_BINARY_INV);
+    cv::Mat rowInk, colInk;
+    cv::reduce(ink, rowInk, 1, cv::REDUCE_SUM, CV_32S);
+    cv::reduce(ink, colInk, 0, cv::REDUCE_SUM, CV_32S);
+
+    const int top = content_start(rowInk, binary.cols);
+    const int bottom = content_end(rowInk, binary.cols);
+    const int left = content_start(colInk, binary.rows);
+    const int right = content_end(colInk, binary.rows);
+    if (top >= bottom || left >= right) return binary; // nothing but edges or blank
+
+    const cv::Rect content(
+        std::max(0, left - PADDING), std::max(0, top - PADDING),
+        std::min(binary.cols, right + PADDING) - std::max(0, left - PADDING),
+        std::min(binary.rows, bottom + PADDING) - std::max(0, top - PADDING));
+    return binary(content);
+}
+
+cv::Mat preprocess_page(const cv::Mat& gray, const PreprocessOptions& options,
+    std::vector<StageTiming>* timings) {
+    cv::Mat page = gray;
+
+    auto run = [&](const char* stage, auto&& apply) {
+        const auto start = std::chrono::steady_clock::now();
+        page = apply(page);
+        if (timings) {
+            timings->push_back(StageTiming{ stage,
+                std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now() - start).count() });
+        }
+    };
+
+    if (options.denoise) {
+        run("denoise", [](const cv::Mat& in) {
+            cv::Mat out;
+            cv::medianBlur(in, out, 3);
+            return out;
+        });
+    }
+
+    if (!options.binarize) return page;
+
+    run("binarize", [&](const cv::Mat& in) {
+        return sauvola_binarize(in, options.sauvolaWindow, options.sauvolaK);
+    });
+
+    if (options.deskew) {
+        run("deskew", [&](const cv::Mat& in) {
+            // Below this the rotation costs more than it helps
+            const double MIN_CORRECTION_DEGREES = 0.1;
+
+            const double angle = estimate_skew(in, options.maxSkewDegrees);
+            return std::abs(angle) < MIN_CORRECTION_DEGREES ? in : rotate_page(in, angle);
+        });
+    }
+
+    if (options.cropBorders) {
+        run("crop", [](const cv::Mat& in) { return crop_borders(in); });
+    }
+    return page;
+}
+
+// Reverses the bits of a byte: SSE2's movemask puts the first pixel in the
+// lowest bit, Tesseract wants it in the highest.
+static std::uint8_t reverse_bits(std::uint8_t b) {
+    b = static_cast<std::uint8_t>((b & 0xF0) >> 4 | (b & 0x0F) << 4);
+    b = static_cast<std::uint8_t>((b & 0xCC) >> 2 | (b & 0x33) << 2);
+    b = static_cast<std::uint8_t>((b & 0xAA) >> 1 | (b & 0x55) << 1);
+    return b;
+}
+
+// One row of pack_binary(). reversed maps each byte to its bit reversal.
+static void pack_row(const std::uint8_t* in, std::uint8_t* out, int width,
+    const std::uint8_t* reversed) {
+    int x = 0;
+
+#ifdef OCR_PREPROCESS_SSE2
+    // 16 pixels to 2 bytes: the top bit of 0xFF (white) is set
+    for (; x + 16 <= width; x += 16) {
+        const int bits = _mm_movemask_epi8(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + x)));
+        out[x / 8] = reversed[bits & 0xFF];
+        out[x / 8 + 1] = reversed[(bits >> 8) & 0xFF];
+    }
+#else
+    (void)reversed;
+#endif
+
+    for (; x < width; x += 8) {
+        std::uint8_t byte = 0;
+        for (int bit = 0; bit < 8; ++bit) {
+            // Padding past the last pixel is left black (0)
+            if (x + bit < width && in[x + bit] >= 128) {
+                byte |= static_cast<std::uint8_t>(0x80 >> bit);
+            }
+        }
+        out[x / 8] = byte;
+    }
+}
+
+cv::Mat pack_binary(const cv::Mat& binary) {
+    std::uint8_t reversed[256];
+    for (int i = 0; i < 256; ++i) reversed[i] = reverse_bits(static_cast<std::uint8_t>(i));
+
+    cv::Mat packed(binary.rows, (binary.cols + 7) / 8, CV_8UC1);
+    for (int y = 0; y < binary.rows; ++y) {
+        pack_row(binary.ptr<std::uint8_t>(y), packed.ptr<std::uint8_t>(y), binary.cols, reversed);
+    }
+    return packed;
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "OcrProcessor.h"
+
+#include <opencv2/opencv.hpp>
+
+#include <vector>
+
+// Cleans up an 8-bit grayscale page before recognition, running the stages
+// enabled in options in this order:
+//   denoise   3x3 median filter (salt-and-pepper noise from phone cameras)
+//   binarize  Sauvola adaptive threshold, to 0 (ink) / 255 (paper)
+//   deskew    estimates the text lines' angle and rotates it away
+//   crop      removes dark scanner edges and blank margins
+// Deskew and crop need binarize and are skipped without it. Appends one
+// entry per stage run to timings, if given.
+cv::Mat preprocess_page(const cv::Mat& gray, const PreprocessOptions& options,
+    std::vector<StageTiming>* timings = nullptr);
+
+// Sauvola threshold: a pixel is ink if it is darker than
+// mean * (1 + k * (stddev / 128 - 1)) over the window around it.
+cv::Mat sauvola_binarize(const cv::Mat& gray, int window, double k);
+
+// Angle of the text lines in a binarized page, in degrees, within
+// +/-maxDegrees; rotating the page by it (cv::getRotationMatrix2D
+// convention) makes them horizontal.
+double estimate_skew(const cv::Mat& binary, double maxDegrees);
+
+// Packs a 0/255 image into 1 bit per pixel, most significant bit first, 1
+// for white: the layout Tesseract's SetImage() takes with 0 bytes per
+// pixel. Rows are padded to whole bytes.
+cv::Mat pack_binary(const cv::Mat& binary);
@@ -0,0 +1,385 @@
+#include "ResultCache.h"
+#include "Logger.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <system_error>
+#include <tuple>
+
+namespace fs = std::filesystem;
+
+// Rough bookkeeping cost of one entry beyond its text (list node, index
+// slot, key), so many tiny results still count against the limit.
+static const std::size_t ENTRY_OVERHEAD_BYTES = 128;
+
+// Allocation unit result files are counted in; most are well under one.
+static const std::uint64_t DISK_BLOCK_BYTES = 4096;
+
+static const char* const RESULT_SUFFIX = ".txt";
+static const char* const TMP_SUFFIX = ".tmp";
+
+// Secret for the content hash, next to the result files it keys
+static const char* const HASH_KEY_FILE = "hash.key";
+
+ContentHashKey random_content_hash_key() {
+    std::random_device random;
+    ContentHashKey key;
+    key.k0 = (static_cast<std::uint64_t>(random()) << 32) ^ random();
+    key.k1 = (static_cast<std::uint64_t>(random()) << 32) ^ random();
+    return key;
+}
+
+static inline std::uint64_t rotl64(std::uint64_t x, int b) {
+    return (x << b) | (x >> (64 - b));
+}
+
+ContentHash hash_image_bytes(const std::string& bytes, const ContentHashKey& key) {
+    // SipHash-2-4 with the 128-bit output (Aumasson and Bernstein, CC0)
+    std::uint64_t v0 = 0x736f6d6570736575ULL ^ key.k0;
+    std::uint64_t v1 = 0x646f72616e646f6dULL ^ key.k1 ^ 0xee;
+    std::uint64_t v2 = 0x6c7967656e657261ULL ^ key.k0;
+    std::uint64_t v3 = 0x7465646279746573ULL ^ key.k1;
+
+    auto round = [&] {
+        v0 += v1; v1 = rotl64(v1, 13); v1 ^= v0; v0 = rotl64(v0, 32);
+        v2 += v3; v3 = rotl64(v3, 16); v3 ^= v2;
+        v0 += v3; v3 = rotl64(v3, 21); v3 ^= v0;
+        v2 += v1; v1 = rotl64(v1, 17); v1 ^= v2; v2 = rotl64(v2, 32);
+    };
+
+    const std::size_t len = bytes.size();
+    const unsigned char* data = reinterpret_cast<const unsigned char*>(bytes.data());
+    const unsigned char* end = data + (len / 8) * 8;
+
+    for (; data != end; data += 8) {
+        std::uint64_t m;
+        std::memcpy(&m, data, sizeof(m));
+        v3 ^= m;
+        round();
+        round();
+        v0 ^= m;
+    }
+
+    std::uint64_t last = static_cast<std::uint64_t>(len) << 56;
+    switch (len & 7) {
+    case 7: last |= static_cast<std::uint64_t>(data[6]) << 48; [[fallthrough]];
+    case 6: last |= static_cast<std::uint64_t>(data[5]) << 40; [[fallthrough]];
+    case 5: last |= static_cast<std::uint64_t>(data[4]) << 32; [[fallthrough]];
+    case 4: last |= static_cast<std::uint64_t>(data[3]) << 24; [[fallthrough]];
+    case 3: last |= static_cast<std::uint64_t>(data[2]) << 16; [[fallthrough]];
+    case 2: last |= static_cast<std::uint64_t>(data[1]) << 8; [[fallthrough]];
+    case 1: last |= static_cast<std::uint64_t>(data[0]);
+    }
+    v3 ^= last;
+    round();
+    round();
+    v0 ^= last;
+
+    ContentHash hash;
+    v2 ^= 0xee;
+    for (int i = 0; i < 4; ++i) round();
+    hash.lo = v0 ^ v1 ^ v2 ^ v3;
+    v1 ^= 0xdd;
+    for (int i = 0; i < 4; ++i) round();
+    hash.hi = v0 ^ v1 ^ v2 ^ v3;
+    return hash;
+}
+
+ResultCache::ResultCache(std::size_t maxMemoryBytes, std::string diskDir,
+    std::uint64_t maxDiskBytes)
+    : maxMemoryBytes_(maxMemoryBytes), diskDir_(std::move(diskDir)),
+    hashKey_(random_content_hash_key()), maxDiskBytes_(maxDiskBytes) {
+    if (!diskDir_.empty()) {
+        std::error_code ec;
+        fs::create_directories(diskDir_, ec);
+        if (ec) {
+            LOG_WARN("result cache: disk tier disabled").kv("dir", diskDir_)
+                .kv("error", ec.message());
+            diskDir_.clear();
+        }
+    }
+    if (!diskDir_.empty()) {
+        std::random_device random;
+        tmpPrefix_ = (static_cast<std::uint64_t>(random()) << 32) ^ random();
+        const bool keyExisted = loadHashKey();
+        if (!diskDir_.empty()) loadDiskIndex(keyExisted);
+    }
+
+    LOG_INFO("result cache").kv("memory_mb", maxMemoryBytes_ / (1024 * 1024))
+        .kv("disk_dir", diskDir_.empty() ? std::string("none") : diskDir_)
+        .kv("disk_mb", maxDiskBytes_ / (1024 * 1024))
+        .kv("disk_files", diskIndex_.size());
+}
+
+// Disables the disk tier if a new secret cannot be saved: results written
+// under it would be unreadable after a restart.
+bool ResultCache::loadHashKey() {
+    const std::string path = diskPath(HASH_KEY_FILE);
+    {
+        std::ifstream in(path);
+        std::string hex;
+        if (in >> hex && hex.size() == 32
+            && hex.find_first_not_of("0123456789abcdef") == std::string::npos) {
+            hashKey_.k0 = std::stoull(hex.substr(0, 16), nullptr, 16);
+            hashKey_.k1 = std::stoull(hex.substr(16), nullptr, 16);
+            return true;
+        }
+    }
+
+    char hex[40];
+    std::snprintf(hex, sizeof(hex), "%016llx%016llx\n",
+        static_cast<unsigned long long>(hashKey_.k0),
+        static_cast<unsigned long long>(hashKey_.k1));
+    char tmpName[64];
+    std::snprintf(tmpName, sizeof(tmpName), ".%016llx%s",
+        static_cast<unsigned long long>(tmpPrefix_), TMP_SUFFIX);
+    const std::string tmpPath = path + tmpName;
+
+    std::error_code ec;
+    {
+        std::ofstream out(tmpPath, std::ios::trunc);
+        out << hex;
+        if (!out) ec = std::make_error_code(std::errc::io_error);
+    }
+    if (!ec) {
+        fs::permissions(tmpPath, fs::perms::owner_read | fs::perms::owner_write, ec);
+    }
+    if (!ec) fs::rename(tmpPath, path, ec);
+    if (ec) {
+        std::error_code ignored;
+        fs::remove(tmpPath, ignored);
+        LOG_WARN("result cache: cannot save hash key, disk tier disabled").kv("path", path)
+            .kv("error", ec.message());
+        diskDir_.clear();
+    }
+    return false;
+}
+
+// Takes over the result files a previous run left, most recently written
+// first, and deletes temporary files from writes that never finished.
+// Without keepFiles, result files are deleted too.
+void ResultCache::loadDiskIndex(bool keepFiles) {
+    std::vector<std::tuple<fs::file_time_type, std::string, std::uint64_t>> files;
+    std::error_code ec;
+    for (fs::directory_iterator it(diskDir_, ec), end; !ec && it != end; it.increment(ec)) {
+        std::error_code fileEc;
+        const fs::path& path = it->path();
+        if (path.extension() == TMP_SUFFIX) {
+            fs::remove(path, fileEc);
+            continue;
+        }
+        if (path.extension() != RESULT_SUFFIX || !it->is_regular_file(fileEc)) continue;
+        if (!keepFiles) {
+            fs::remove(path, fileEc);
+            continue;
+        }
+
+        const std::uint64_t size = it->file_size(fileEc);
+        const fs::file_time_type written = it->last_write_time(fileEc);
+        if (!fileEc) files.emplace_back(written, path.filename().string(), size);
+    }
+    std::sort(files.begin(), files.end());
+
+    std::vector<std::string> evicted;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& file : files) {
+            for (auto& name : touchDiskLocked(std::get<1>(file), std::get<2>(file))) {
+                evicted.push_back(std::move(name));
+            }
+        }
+    }
+    removeDiskFiles(evicted);
+}
+
+ResultCacheKey ResultCache::makeKey(const std::string& imageBytes, const std::string& config,
+    const ContentHashKey& hashKey) {
+    ResultCacheKey key;
+    key.hash = hash_image_bytes(imageBytes, hashKey);
+    key.size = imageBytes.size();
+    key.config = config;
+    return key;
+}
+
+bool ResultCache::lookup(const ResultCacheKey& key, std::string& text) {
+    const std::string name = diskDir_.empty() ? std::string() : diskFileName(key);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++stats_.lookups;
+
+        auto it = index_.find(key);
+        if (it != index_.end()) {
+            lru_.splice(lru_.begin(), lru_, it->second);
+            text = it->second->text;
+            ++stats_.memoryHits;
+            stats_.bytesSaved += key.size;
+            return true;
+        }
+
+        // Only files in the index are read, so a miss never touches the disk
+        if (name.empty() || !diskIndex_.count(name)) return false;
+    }
+
+    const std::string path = diskPath(name);
+    {
+        std::ifstream in(path, std::ios::binary);
+        if (!in) return false;
+
+        std::ostringstream contents;
+        contents << in.rdbuf();
+        text = contents.str();
+    }
+
+    // Its modification time is its place in line for eviction after a restart
+    std::error_code ec;
+    fs::last_write_time(path, fs::file_time_type::clock::now(), ec);
+
+    std::vector<std::string> evicted;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++stats_.diskHits;
+        stats_.bytesSaved += key.size;
+        insertMemoryLocked(key, text);
+        evicted = touchDiskLocked(name, text.size());
+    }
+    removeDiskFiles(evicted);
+    return true;
+}
+
+void ResultCache::insert(const ResultCacheKey& key, const std::string& text) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        insertMemoryLocked(key, text);
+    }
+
+    if (diskDir_.empty()) return;
+
+    // Write under a temporary name and rename, so a crash never leaves a
+    // truncated result behind for the next run to serve. Writers of the
+    // same result each use their own temporary file.
+    const std::string name = diskFileName(key);
+    const std::string path = diskPath(name);
+    char tmpName[64];
+    std::snprintf(tmpName, sizeof(tmpName), ".%016llx-%llu%s",
+        static_cast<unsigned long long>(tmpPrefix_),
+        static_cast<unsigned long long>(tmpSeq_.fetch_add(1)), TMP_SUFFIX);
+    const std::string tmpPath = path + tmpName;
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        out.write(text.data(), static_cast<std::streamsize>(text.size()));
+        if (!out) {
+            LOG_WARN("result cache: write failed").kv("path", tmpPath);
+            return;
+        }
+    }
+
+    std::error_code ec;
+    fs::rename(tmpPath, path, ec);
+    if (ec) {
+        fs::remove(tmpPath, ec);
+        return;
+    }
+
+    std::vector<std::string> evicted;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        evicted = touchDiskLocked(name, text.size());
+    }
+    removeDiskFiles(evicted);
+}
+
+ResultCacheStats ResultCache::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ResultCacheStats out = stats_;
+    out.entries = index_.size();
+    out.memoryBytes = memoryBytes_;
+    out.diskEntries = diskIndex_.size();
+    out.diskBytes = diskBytes_;
+    return out;
+}
+
+void ResultCache::insertMemoryLocked(const ResultCacheKey& key, const std::string& text) {
+    auto it = index_.find(key);
+    if (it != index_.end()) {
+        lru_.splice(lru_.begin(), lru_, it->second);
+        return;
+    }
+
+    Entry entry{ key, text };
+    const std::size_t bytes = entryBytes(entry);
+    if (bytes > maxMemoryBytes_) return;
+
+    lru_.push_front(std::move(entry));
+    index_.emplace(key, lru_.begin());
+    memoryBytes_ += bytes;
+
+    while (memoryBytes_ > maxMemoryBytes_) {
+        const Entry& oldest = lru_.back();
+        memoryBytes_ -= entryBytes(oldest);
+        index_.erase(oldest.key);
+        lru_.pop_back();
+    }
+}
+
+std::vector<std::string> ResultCache::touchDiskLocked(const std::string& name,
+    std::uint64_t bytes) {
+    auto it = diskIndex_.find(name);
+    if (it != diskIndex_.end()) {
+        diskBytes_ -= it->second->bytes;
+        diskLru_.erase(it->second);
+        diskIndex_.erase(it);
+    }
+
+    diskLru_.push_front(DiskFile{ name, diskFileBytes(bytes) });
+    diskIndex_.emplace(name, diskLru_.begin());
+    diskBytes_ += diskLru_.front().bytes;
+
+    std::vector<std::string> evicted;
+    while (diskBytes_ > maxDiskBytes_ && !diskLru_.empty()) {
+        const DiskFile& oldest = diskLru_.back();
+        diskBytes_ -= oldest.bytes;
+        evicted.push_back(oldest.name);
+        diskIndex_.erase(oldest.name);
+        diskLru_.pop_back();
+    }
+    return evicted;
+}
+
+// A file that cannot be deleted (still open for a read, say) is no longer
+// counted; it is picked up again at the next start.
+void ResultCache::removeDiskFiles(const std::vector<std::string>& names) {
+    for (const auto& name : names) {
+        std::error_code ec;
+        fs::remove(diskPath(name), ec);
+    }
+}
+
+std::string ResultCache::diskFileName(const ResultCacheKey& key) const {
+    char name[96];
+    std::snprintf(name, sizeof(name), "%016llx%016llx-%llx-%016llx%s",
+        static_cast<unsigned long long>(key.hash.hi),
+        static_cast<unsigned long long>(key.hash.lo),
+        static_cast<unsigned long long>(key.size),
+        static_cast<unsigned long long>(hash_image_bytes(key.config, hashKey_).lo),
+        RESULT_SUFFIX);
+    return name;
+}
+
+std::string ResultCache::diskPath(const std::string& name) const {
+    return (fs::path(diskDir_) / name).string();
+}
+
+std::size_t ResultCache::entryBytes(const Entry& entry) {
+    return entry.text.size() + entry.key.config.size() + ENTRY_OVERHEAD_BYTES;
+}
+
+std::uint64_t ResultCache::diskFileBytes(std::uint64_t size) {
+    const std::uint64_t blocks = std::max<std::uint64_t>(1,
+        (size + DISK_BLOCK_BYTES - 1) / DISK_BLOCK_BYTES);
+    return blocks * DISK_BLOCK_BYTES;
+}
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Secret the content hash is keyed with. Without it nobody can construct
+// two images with the same hash, so a cache hit cannot be forged.
+struct ContentHashKey {
+    std::uint64_t k0 = 0;
+    std::uint64_t k1 = 0;
+};
+
+ContentHashKey random_content_hash_key();
+
+// 128-bit keyed content hash of an image (SipHash-2-4-128).
+struct ContentHash {
+    std::uint64_t lo = 0;
+    std::uint64_t hi = 0;
+
+    bool operator==(const ContentHash& other) const {
+        return lo == other.lo && hi == other.hi;
+    }
+};
+
+ContentHash hash_image_bytes(const std::string& bytes, const ContentHashKey& key);
+
+// Identifies a result: the image's hash and size plus the recognition
+// settings (ocr_config_key()) it was read with.
+struct ResultCacheKey {
+    ContentHash hash;
+    std::uint64_t size = 0;
+    std::string config;
+
+    bool operator==(const ResultCacheKey& other) const {
+        return hash == other.hash && size == other.size && config == other.config;
+    }
+};
+
+struct ResultCacheKeyHash {
+    std::size_t operator()(const ResultCacheKey& key) const {
+        return static_cast<std::size_t>(key.hash.lo ^ (key.size * 0x9E3779B97F4A7C15ULL));
+    }
+};
+
+struct ResultCacheStats {
+    std::uint64_t lookups = 0;
+    std::uint64_t memoryHits = 0;
+    std::uint64_t diskHits = 0;
+    std::uint64_t bytesSaved = 0; // image bytes that did not need OCR
+    std::size_t entries = 0;      // in memory
+    std::size_t memoryBytes = 0;
+    std::size_t diskEntries = 0;
+    std::uint64_t diskBytes = 0;  // as counted against maxDiskBytes
+};
+
+// OCR results keyed by image content, so resubmitted images skip decoding
+// and recognition entirely. Two tiers:
+//   memory: LRU, bounded by maxMemoryBytes;
+//   disk:   optional, one small file per result under diskDir, so results
+//           survive restarts. Read on a memory miss and promoted. Bounded
+//           by maxDiskBytes (each file counted in whole 4 KiB blocks); the
+//           least recently written or read files are deleted first.
+// Keys are hashed with a secret kept in diskDir next to the results (a new
+// random one per process without a disk tier); if it has to be created,
+// result files already there are deleted, as they cannot be looked up.
+// Thread-safe; disk I/O is done outside the lock.
+class ResultCache {
+public:
+    static const std::uint64_t DEFAULT_MAX_DISK_BYTES = 1024ULL * 1024 * 1024;
+
+    // Files already in diskDir are taken over, oldest first by their
+    // modification time.
+    explicit ResultCache(std::size_t maxMemoryBytes, std::string diskDir = std::string(),
+        std::uint64_t maxDiskBytes = DEFAULT_MAX_DISK_BYTES);
+
+    static ResultCacheKey makeKey(const std::string& imageBytes, const std::string& config,
+        const ContentHashKey& hashKey);
+
+    // The secret keys for this cache must be made with.
+    const ContentHashKey& hashKey() const { return hashKey_; }
+
+    // Returns true and fills text on a hit.
+    bool lookup(const ResultCacheKey& key, std::string& text);
+    void insert(const ResultCacheKey& key, const std::string& text);
+
+    ResultCacheStats stats() const;
+
+private:
+    struct Entry {
+        ResultCacheKey key;
+        std::string text;
+    };
+
+    // A result file, in diskLru_.
+    struct DiskFile {
+        std::string name;
+        std::uint64_t bytes = 0;
+    };
+
+    void insertMemoryLocked(const ResultCacheKey& key, const std::string& text);
+    std::string diskFileName(const ResultCacheKey& key) const;
+    std::string diskPath(const std::string& name) const;
+
+    // Reads the secret from diskDir, or creates it there; false if it had
+    // to be created.
+    bool loadHashKey();
+    void loadDiskIndex(bool keepFiles);
+    // Records name, a file of size bytes, as the most recently used one and
+    // returns the files to delete to get back under maxDiskBytes_.
+    std::vector<std::string> touchDiskLocked(const std::string& name, std::uint64_t bytes);
+    void removeDiskFiles(const std::vector<std::string>& names);
+
+    static std::size_t entryBytes(const Entry& entry);
+    static std::uint64_t diskFileBytes(std::uint64_t size);
+
+    mutable std::mutex mutex_;
+    std::list<Entry> lru_; // most recently used first
+    std::unordered_map<ResultCacheKey, std::list<Entry>::iterator, ResultCacheKeyHash> index_;
+    std::size_t memoryBytes_ = 0;
+    std::size_t maxMemoryBytes_;
+    std::string diskDir_;
+    ContentHashKey hashKey_;
+
+    std::list<DiskFile> diskLru_; // most recently used first
+    std::unordered_map<std::string, std::list<DiskFile>::iterator> diskIndex_;
+    std::uint64_t diskBytes_ = 0;
+    std::uint64_t maxDiskBytes_;
+
+    // Temporary file names: unique per writer, and per process sharing diskDir
+    std::uint64_t tmpPrefix_ = 0;
+    std::atomic<std::uint64_t> tmpSeq_{ 0 };
+
+    ResultCacheStats stats_;
+};
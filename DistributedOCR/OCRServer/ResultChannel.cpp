@@ -0,0 +1,113 @@
+#include "ResultChannel.h"
+#include "Logger.h"
+
+#include <algorithm>
+
+// How often next() checks stopRequested while it waits.
+static const auto STOP_POLL_INTERVAL = std::chrono::milliseconds(100);
+
+ResultChannel::Ticket ResultChannel::expect(int id, Clock::time_point deadline) {
+    Ticket ticket;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ticket = nextTicket_++;
+        outstanding_.emplace(ticket, Outstanding{ id, deadline });
+    }
+    cv_.notify_all();
+    return ticket;
+}
+
+void ResultChannel::close() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closed_ = true;
+    }
+    cv_.notify_all();
+}
+
+void ResultChannel::push(Ticket ticket, ocr::BatchResult result) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = outstanding_.find(ticket);
+        if (it == outstanding_.end()) {
+            return; // already reported as timed out
+        }
+        outstanding_.erase(it);
+        ready_.push_back(std::move(result));
+    }
+    cv_.notify_all();
+}
+
+bool ResultChannel::next(ocr::BatchResult& out,
+    const std::function<bool()>& stopRequested) {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    // Wait until wakeAt, but no longer than the stop poll interval
+    auto waitUntil = [&](Clock::time_point wakeAt) {
+        if (stopRequested) {
+            wakeAt = std::min(wakeAt, Clock::now() + STOP_POLL_INTERVAL);
+        }
+        if (wakeAt == Clock::time_point::max()) {
+            cv_.wait(lock);
+        }
+        else {
+            cv_.wait_until(lock, wakeAt);
+        }
+    };
+
+    while (true) {
+        if (stopRequested && stopRequested()) {
+            return false;
+        }
+
+        if (!ready_.empty()) {
+            out = std::move(ready_.front());
+            ready_.pop_front();
+            cv_.notify_all(); // room for a waiting reader
+            return true;
+        }
+
+        if (outstanding_.empty()) {
+            if (closed_) return false;
+            waitUntil(Clock::time_point::max());
+            continue;
+        }
+
+        auto earliest = outstanding_.begin();
+        for (auto it = outstanding_.begin(); it != outstanding_.end(); ++it) {
+            if (it->second.deadline < earliest->second.deadline) earliest = it;
+        }
+
+        if (earliest->second.deadline <= Clock::now()) {
+            LOG_WARN("task timed out").kv("id", earliest->second.id);
+
+            out.Clear();
+            out.set_id(earliest->second.id);
+            out.set_text("[TIMEOUT] OCR took too long");
+            out.set_processing_time_ms(0);
+            outstanding_.erase(earliest);
+            cv_.notify_all();
+            return true;
+        }
+
+        waitUntil(earliest->second.deadline);
+    }
+}
+
+bool ResultChannel::waitForRoom(std::size_t maxInFlight,
+    const std::function<bool()>& stopRequested) {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while (outstanding_.size() + ready_.size() >= maxInFlight) {
+        if (stopRequested && stopRequested()) {
+            return false;
+        }
+        if (stopRequested) {
+            cv_.wait_for(lock, STOP_POLL_INTERVAL);
+        }
+        else {
+            cv_.wait(lock);
+        }
+    }
+    return true;
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "ocr_service.pb.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+
+// Hands finished BatchResults from worker callbacks to the thread that owns
+// a streaming RPC, in completion order, and turns tasks that miss their
+// deadline into "[TIMEOUT]" results. Held through a shared_ptr so late
+// callbacks stay safe after the RPC has returned.
+//
+// Tasks are tracked by a ticket of the channel's own rather than by their
+// id, which comes from the client and need not be unique.
+class ResultChannel {
+public:
+    using Clock = std::chrono::steady_clock;
+    using Ticket = std::uint64_t;
+
+    // Registers a task whose result will arrive through push() with the
+    // returned ticket. id is what its timeout entry is reported under.
+    Ticket expect(int id, Clock::time_point deadline);
+
+    // No more expect() calls will follow.
+    void close();
+
+    // Delivers the result of the task given ticket. Results for tasks that
+    // already timed out are dropped.
+    void push(Ticket ticket, ocr::BatchResult result);
+
+    // Blocks until the next result (or timeout entry) is available.
+    // Returns false once the channel is closed and nothing is outstanding,
+    // or as soon as stopRequested (polled while waiting) returns true.
+    bool next(ocr::BatchResult& out,
+        const std::function<bool()>& stopRequested = nullptr);
+
+    // Blocks while maxInFlight results are outstanding or not yet taken by
+    // next(). Used by stream readers to stop reading uploads, so HTTP/2 flow
+    // control pushes back on the client instead of the pool filling up.
+    // Returns false if stopRequested (polled while waiting) returns true.
+    bool waitForRoom(std::size_t maxInFlight,
+        const std::function<bool()>& stopRequested = nullptr);
+
+private:
+    struct Outstanding {
+        int id;
+        Clock::time_point deadline;
+    };
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<ocr::BatchResult> ready_;
+    std::map<Ticket, Outstanding> outstanding_;
+    Ticket nextTicket_ = 0;
+    bool closed_ = false;
+};
@@ -1,139 +1,529 @@
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
 #include <iostream>
 #include <memory>
+#include <sstream>
 #include <string>
 #include <thread>
 #include <vector>
 #include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <utility>
 
 #include <grpcpp/grpcpp.h>
+#include <grpcpp/resource_quota.h>
 #include "ocr_service.grpc.pb.h"
 
-#include "OcrProcessor.h"
+#include "AsyncBatchServer.h"
+#include "CommandLine.h"
+#include "CpuTopology.h"
+#include "Logger.h"
+#include "OcrServiceImpl.h"
 #include "OcrWorkerPool.h"
+#include "PoolAutoscaler.h"
+#include "ResultCache.h"
 
 using grpc::Server;
 using grpc::ServerBuilder;
-using grpc::ServerContext;
-using grpc::Status;
 
-using ocr::OCRService;
-using ocr::BatchRequest;
-using ocr::BatchResponse;
-using ocr::ImageTask;
-using ocr::BatchResult;
+// "850us", "12.3ms" or "4.1s".
+static std::string format_micros(std::uint64_t us) {
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(1);
+    if (us < 1000) out << us << "us";
+    else if (us < 1000000) out << us / 1000.0 << "ms";
+    else out << us / 1000000.0 << "s";
+    return out.str();
+}
 
-class OCRServiceImpl final : public OCRService::Service {
+// Logs per-class queue depth and waiting time, the result cache's hit rate
+// and per-stage latency percentiles, every interval while the pool has been
+// busy, until stop() is called.
+class PoolStatsReporter {
 public:
-    explicit OCRServiceImpl(std::size_t numThreads)
-        : pool_(numThreads, 100) {
+    PoolStatsReporter(const OcrWorkerPool& pool, const ResultCache* cache,
+        std::chrono::seconds interval)
+        : pool_(pool), cache_(cache), interval_(interval),
+        thread_(&PoolStatsReporter::run, this) {
     }
 
-    Status ProcessBatch(ServerContext* context,
-        const BatchRequest* request,
-        BatchResponse* reply) override {
-        int taskCount = request->tasks_size();
-        std::cout << "Received batch with " << taskCount << " tasks.\n";
+    ~PoolStatsReporter() { stop(); }
 
-        if (taskCount == 0) {
-            return Status(grpc::StatusCode::INVALID_ARGUMENT,
-                "BatchRequest.tasks is empty");
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
         }
+        cv_.notify_all();
+        if (thread_.joinable()) thread_.join();
+    }
 
-        // Enqueue all tasks into the worker pool
-        std::vector<std::future<OcrResult>> futures;
-        futures.reserve(taskCount);
-        std::vector<int> ids;
-        ids.reserve(taskCount);
+private:
+    void run() {
+        std::vector<std::uint64_t> lastStarted(JOB_PRIORITY_COUNT, 0);
+        std::uint64_t lastLookups = 0;
+        std::uint64_t lastCoalesced = 0;
 
-        for (const auto& task : request->tasks()) {
-            std::cout << "  Enqueue task id=" << task.id()
-                << " (" << task.image_data().size() << " bytes)\n";
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (!cv_.wait_for(lock, interval_, [this] { return stopping_; })) {
+            const auto stats = pool_.classStats();
 
-            ids.push_back(task.id());
-            futures.push_back(pool_.enqueue(task.id(), task.image_data()));
-        }
+            bool busy = false;
+            for (const auto& s : stats) {
+                const auto p = static_cast<int>(s.priority);
+                busy = busy || s.queued > 0 || s.started != lastStarted[p];
+                lastStarted[p] = s.started;
+            }
+            const std::uint64_t coalesced = pool_.coalescedJobs();
+            busy = busy || coalesced != lastCoalesced;
 
-        // Collect results in the same order
-        for (std::size_t i = 0; i < futures.size(); ++i) {
-            using namespace std::chrono;
+            ResultCacheStats cacheStats;
+            if (cache_) {
+                cacheStats = cache_->stats();
+                busy = busy || cacheStats.lookups != lastLookups;
+                lastLookups = cacheStats.lookups;
+            }
+            if (!busy) continue;
+
+            for (const auto& s : stats) {
+                LOG_INFO("queue stats").kv("priority", priority_name(s.priority))
+                    .kv("queued", s.queued)
+                    .kv("started", s.started)
+                    .kv("avg_wait_ms", static_cast<long long>(s.avgWaitMs))
+                    .kv("oldest_wait_ms", static_cast<long long>(s.oldestWaitMs));
+            }
 
-            // Dynamically set timeout based on image size
-            const auto& task = request->tasks(i);
-            int timeoutSeconds = 30; // Default 30 seconds
+            if (coalesced != lastCoalesced) {
+                LOG_INFO("coalesced duplicate jobs").kv("count", coalesced - lastCoalesced);
+                lastCoalesced = coalesced;
+            }
 
-            // LOWER threshold so the demo works with normal 4K images
-            const std::size_t LARGE_IMAGE_BYTES = 500 * 1024;  // 500 KB threshold
+            if (cache_ && cacheStats.lookups > 0) {
+                const std::uint64_t hits = cacheStats.memoryHits + cacheStats.diskHits;
+                LOG_INFO("cache stats").kv("hit_rate_pct", 100 * hits / cacheStats.lookups)
+                    .kv("memory_hits", cacheStats.memoryHits)
+                    .kv("disk_hits", cacheStats.diskHits)
+                    .kv("misses", cacheStats.lookups - hits)
+                    .kv("bytes_saved", cacheStats.bytesSaved)
+                    .kv("entries", cacheStats.entries)
+                    .kv("memory_bytes", cacheStats.memoryBytes)
+                    .kv("disk_entries", cacheStats.diskEntries)
+                    .kv("disk_bytes", cacheStats.diskBytes);
+            }
 
-            if (task.image_data().size() > LARGE_IMAGE_BYTES) {
-                timeoutSeconds = 120; // Extended timeout for large images
-                std::cout << "[LARGE IMAGE] Using extended timeout (" << timeoutSeconds
-                    << "s) for id=" << ids[i]
-                    << " (" << task.image_data().size() << " bytes)\n";
+            const StageLatencies& latencies = pool_.stageLatencies();
+            const std::pair<const char*, const LatencyHistogram*> stages[] = {
+                { "queue_wait", &latencies.queueWait },
+                { "decode", &latencies.decode },
+                { "preprocess", &latencies.preprocess },
+                { "layout", &latencies.layout },
+                { "engine_wait", &latencies.engineWait },
+                { "recognition", &latencies.recognition },
+                { "total", &latencies.total },
+            };
+            for (const auto& stage : stages) {
+                const HistogramSnapshot snap = stage.second->snapshot();
+                if (snap.count == 0) continue;
+                LOG_INFO("stage latency since start").kv("stage", stage.first)
+                    .kv("p50", format_micros(snap.percentile(0.50)))
+                    .kv("p95", format_micros(snap.percentile(0.95)))
+                    .kv("p99", format_micros(snap.percentile(0.99)))
+                    .kv("n", snap.count);
             }
+        }
+    }
 
+    const OcrWorkerPool& pool_;
+    const ResultCache* cache_;
+    std::chrono::seconds interval_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stopping_ = false;
+    std::thread thread_; // last, so it starts after the members it uses
+};
 
-            auto status = futures[i].wait_for(seconds(timeoutSeconds));
+// Queue slots per worker when --queue-depth is not given; the old fixed
+// queue of 100 for 4 workers.
+static const std::size_t QUEUE_SLOTS_PER_WORKER = 25;
 
-            if (status == std::future_status::timeout) {
-                std::cerr << "Timeout processing task id=" << ids[i]
-                    << " after " << timeoutSeconds << "s\n";
+struct ServerOptions {
+    std::string address = "0.0.0.0:50051";
+    std::size_t workers = 0;    // OCR worker threads, the maximum if elastic; 0: one per non-I/O core
+    std::size_t queueDepth = 0; // jobs queued before admission refuses work; 0: per worker
+    int ioCores = -1;           // cores kept for gRPC I/O threads; -1: from the topology
+    bool pinThreads = false;    // pin workers to their own cores and I/O threads to the I/O cores
+    bool numa = false;          // a worker group per NUMA node; implies work stealing
+    std::size_t minWorkers = 0; // non-zero: elastic pool between this and workers
+    double targetQueueWaitMs = 500.0; // elastic pool: p95 queue wait to stay under
+    bool asyncMode = false;
+    PoolScheduling scheduling = PoolScheduling::EarliestDeadlineFirst;
+    std::size_t cacheMb = 64;  // 0 disables the result cache
+    std::string cacheDir;      // empty: no disk tier
+    std::size_t cacheDiskMb = 1024; // bound on the disk tier
+    double tileMinMegapixels = 0.0; // 0 disables tile-parallel recognition
+    std::size_t engines = 0;        // Tesseract engines per model; 0: one per worker
+    std::size_t warmEngines = 0;    // loaded at startup per language; 0: all of them
+    std::size_t totalEngines = 0;   // across all models; 0: twice engines, or all warm ones
+    std::string tessdataDir;        // empty: the built-in path
+    std::vector<std::string> languages{ "eng" }; // preloaded; others load on first use
+    double maxDecodeMegapixels = 16.0; // larger images are decoded at reduced scale; 0: never
+    int targetDpi = 300;               // 0: ignore the declared resolution
+    PreprocessOptions preprocess;
+    LogLevel logLevel = LogLevel::Info; // per-image lines are Debug
+};
 
-                BatchResult* out = reply->add_results();
-                out->set_id(ids[i]);
-                out->set_text("[TIMEOUT] OCR took too long");
-                out->set_processing_time_ms(0);
-                continue;
-            }
+// Cores kept free of OCR work for gRPC's threads: none on small machines,
+// where every core is needed for recognition, else one in eight.
+static std::size_t default_io_cores(std::size_t cores) {
+    if (cores < 8) return 0;
+    return std::max<std::size_t>(1, cores / 8);
+}
+
+void RunServer(const ServerOptions& options) {
+    const bool asyncMode = options.asyncMode;
+    const std::string& address = options.address;
+
+    // Tesseract is compute bound and gains little from a core's second
+    // hardware thread, so size by physical cores.
+    const CpuTopology& topology = system_topology();
+    const std::size_t cores = topology.coreCount();
+    const std::size_t ioCores = options.ioCores >= 0
+        ? std::min<std::size_t>(static_cast<std::size_t>(options.ioCores), cores - 1)
+        : default_io_cores(cores);
+    const std::size_t numThreads = options.workers > 0
+        ? options.workers : std::max<std::size_t>(1, cores - ioCores);
+    const std::size_t queueDepth = options.queueDepth > 0
+        ? options.queueDepth : QUEUE_SLOTS_PER_WORKER * numThreads;
 
-            try {
-                OcrResult result = futures[i].get();
+    // One I/O thread per hardware thread of the I/O cores, and at least
+    // two. The cores are the ones assign_cores() sets aside, taken from
+    // each NUMA node in turn, whether or not threads are pinned to them.
+    const CoreAssignment assignment = assign_cores(topology, ioCores, numThreads);
+    const std::size_t ioThreads = std::max<std::size_t>(2, assignment.ioCpus.size());
 
-                BatchResult* out = reply->add_results();
-                out->set_id(ids[i]);
-                out->set_text(result.text);
-                out->set_processing_time_ms(result.processingTimeMs);
+    LOG_INFO("cpu topology").kv("layout", topology.describe()).kv("workers", numThreads)
+        .kv("io_cores", ioCores).kv("io_threads", ioThreads).kv("queue_depth", queueDepth);
 
-                std::cout << "Successfully processed task id=" << ids[i]
-                    << " in " << result.processingTimeMs << "ms\n";
+    // Node groups need work stealing's per-worker deques; the shared queue
+    // has nothing to split
+    const bool numa = options.numa && topology.numaNodes > 1;
+    PoolScheduling scheduling = options.scheduling;
+    if (options.numa && !numa) {
+        LOG_INFO("one NUMA node, --numa has no effect");
+    }
+    if (numa && scheduling != PoolScheduling::WorkStealing) {
+        LOG_INFO("NUMA worker groups use work-stealing scheduling");
+        scheduling = PoolScheduling::WorkStealing;
+    }
+
+    CoreAssignment pinning;
+    std::vector<int> workerNodes;
+    WorkerStartHook pinWorker;
+    if (options.pinThreads || numa) {
+        pinning = assignment;
+        if (numa) {
+            for (auto& cpus : pinning.workerCpus) {
+                workerNodes.push_back(topology.nodeOf(cpus.front()));
+                if (options.pinThreads) continue;
+
+                // Unpinned, a worker may still use any core of its node
+                // except the I/O cores
+                std::vector<int> nodeCpus;
+                for (int cpu : topology.nodeCpus(workerNodes.back())) {
+                    if (std::find(pinning.ioCpus.begin(), pinning.ioCpus.end(), cpu)
+                        == pinning.ioCpus.end()) {
+                        nodeCpus.push_back(cpu);
+                    }
+                }
+                if (!nodeCpus.empty()) cpus = std::move(nodeCpus);
             }
-            catch (const std::exception& ex) {
-                std::cerr << "Error processing task id=" << ids[i]
-                    << ": " << ex.what() << "\n";
-
-                BatchResult* out = reply->add_results();
-                out->set_id(ids[i]);
-                out->set_text(std::string("[ERROR] ") + ex.what());
-                out->set_processing_time_ms(0);
+            if (!options.pinThreads) pinning.ioCpus.clear();
+        }
+        pinWorker = [workerCpus = pinning.workerCpus](std::size_t i) {
+            const auto& cpus = workerCpus[i % workerCpus.size()];
+            if (!pin_current_thread(cpus)) {
+                LOG_WARN("could not pin worker").kv("worker", i).kv("cpus", format_cpu_list(cpus));
             }
+        };
+
+        std::vector<int> workerCpus;
+        for (const auto& cpus : pinning.workerCpus) {
+            workerCpus.insert(workerCpus.end(), cpus.begin(), cpus.end());
         }
+        LOG_INFO("pinning threads").kv("io_cpus", format_cpu_list(pinning.ioCpus))
+            .kv("worker_cpus", format_cpu_list(workerCpus))
+            .kv("numa_groups", numa ? topology.numaNodes : 1);
+    }
+
+    configure_decode(static_cast<std::size_t>(options.maxDecodeMegapixels * 1e6),
+        options.targetDpi);
+
+    configure_preprocessing(options.preprocess);
 
-        std::cout << "Batch processing complete. Sent " << reply->results_size()
-            << " results.\n";
-        return Status::OK;
+    // An elastic pool starts small; the rest of its threads are parked
+    const bool elastic = options.minWorkers > 0 && options.minWorkers < numThreads;
+
+    // Load the models before taking requests rather than on each worker's
+    // first image
+    const std::size_t engines = options.engines > 0 ? options.engines : numThreads;
+    const std::size_t warmEngines = options.warmEngines > 0 ? options.warmEngines
+        : elastic ? options.minWorkers : engines;
+    // Models beyond the budget evict idle engines of the least recently
+    // used ones, so each model in use costs memory only while it is in use
+    const std::size_t totalEngines = options.totalEngines > 0 ? options.totalEngines
+        : std::max(2 * engines, options.languages.size() * std::min(warmEngines, engines));
+    init_tess_engines(options.tessdataDir, engines, warmEngines, options.languages,
+        totalEngines);
+
+    // Declared before the pool so it outlives the workers that fill it
+    std::unique_ptr<ResultCache> cache;
+    if (options.cacheMb > 0) {
+        cache = std::make_unique<ResultCache>(options.cacheMb * 1024 * 1024, options.cacheDir,
+            static_cast<std::uint64_t>(options.cacheDiskMb) * 1024 * 1024);
     }
 
-private:
-    OcrWorkerPool pool_;
-};
+    OcrWorkerPool pool(numThreads, queueDepth, scheduling, pinWorker, workerNodes);
+    if (cache) pool.attachCache(*cache);
+    if (options.tileMinMegapixels > 0.0) {
+        pool.setTileMinPixels(static_cast<std::size_t>(options.tileMinMegapixels * 1e6));
+        LOG_INFO("tiling large images across workers")
+            .kv("min_megapixels", options.tileMinMegapixels);
+    }
 
-void RunServer(const std::string& address) {
-    //set number of threads
-    std::size_t numThreads = 4; //std::thread::hardware_concurrency();
-    if (numThreads == 0) numThreads = 4;
+    std::unique_ptr<PoolAutoscaler> autoscaler;
+    if (elastic) {
+        AutoscaleOptions scaling;
+        scaling.minWorkers = options.minWorkers;
+        scaling.targetQueueWaitMs = options.targetQueueWaitMs;
+        autoscaler = std::make_unique<PoolAutoscaler>(pool, scaling);
+    }
+
+    PoolStatsReporter statsReporter(pool, cache.get(), std::chrono::seconds(30));
 
-    OCRServiceImpl service(numThreads);
+    // The sync server polls each completion queue with one idle thread and
+    // runs a call's handler on the thread that picked it up, so it uses
+    // ioThreads threads plus one per call in progress. The quota caps that
+    // at one call per queue slot; calls beyond it are refused with
+    // RESOURCE_EXHAUSTED instead of each starting another thread.
+    const std::size_t maxServerThreads = ioThreads + queueDepth;
+    grpc::ResourceQuota quota("ocr-server");
+    quota.SetMaxThreads(static_cast<int>(maxServerThreads));
 
     ServerBuilder builder;
     builder.AddListeningPort(address, grpc::InsecureServerCredentials());
+    builder.SetResourceQuota(quota);
+    builder.SetSyncServerOption(ServerBuilder::SyncServerOption::NUM_CQS,
+        static_cast<int>(ioThreads));
+    builder.SetSyncServerOption(ServerBuilder::SyncServerOption::MIN_POLLERS, 1);
+    builder.SetSyncServerOption(ServerBuilder::SyncServerOption::MAX_POLLERS, 1);
+    LOG_DEBUG("grpc threads").kv("completion_queues", ioThreads)
+        .kv("max_threads", maxServerThreads);
+
+    // gRPC starts its own threads in BuildAndStart(); on Linux they inherit
+    // this thread's affinity. On Windows new threads take the process's
+    // affinity instead, so there only the async pollers end up pinned.
+    if (!pinning.ioCpus.empty()) pin_current_thread(pinning.ioCpus);
+
+    if (asyncMode) {
+        // ProcessBatch via completion queues, everything else stays sync
+        AsyncOCRService service;
+        service.attachPool(pool);
+        builder.RegisterService(&service);
+
+        AsyncBatchServer asyncServer(builder, service, pool, ioThreads);
+        asyncServer.setPollerCpus(pinning.ioCpus);
+
+        std::unique_ptr<Server> server(builder.BuildAndStart());
+        asyncServer.start();
+        LOG_INFO("server listening").kv("address", address).kv("workers", pool.workerCount())
+            .kv("async", true);
+        server->Wait();
+        return;
+    }
+
+    OCRServiceImpl service;
+    service.attachPool(pool);
     builder.RegisterService(&service);
 
     std::unique_ptr<Server> server(builder.BuildAndStart());
-    std::cout << "Server listening at: " << address
-        << " with " << numThreads << " worker threads.\n";
+    LOG_INFO("server listening").kv("address", address).kv("workers", pool.workerCount());
     server->Wait();
 }
 
-int main() {
-    RunServer("0.0.0.0:50051");
+// "eng,deu,eng+deu" -> { "eng", "deu", "eng+deu" }
+static std::vector<std::string> split_list(const std::string& list) {
+    std::vector<std::string> items;
+    std::size_t start = 0;
+    while (start <= list.size()) {
+        std::size_t end = list.find(',', start);
+        if (end == std::string::npos) end = list.size();
+        if (end > start) items.push_back(list.substr(start, end - start));
+        start = end + 1;
+    }
+    return items;
+}
+
+// Reads "name = value" lines, or just "name" for switches, into the
+// equivalent "--name value" arguments. Names are the command-line flags
+// without the dashes; blank lines and lines starting with '#' are skipped.
+static bool read_config_file(const std::string& path, std::vector<std::string>& args) {
+    std::ifstream in(path);
+    if (!in) return false;
+
+    auto trim = [](const std::string& text) {
+        const std::size_t first = text.find_first_not_of(" \t\r");
+        if (first == std::string::npos) return std::string();
+        return text.substr(first, text.find_last_not_of(" \t\r") - first + 1);
+    };
+
+    std::string line;
+    while (std::getline(in, line)) {
+        line = trim(line);
+        if (line.empty() || line[0] == '#') continue;
+        const std::size_t eq = line.find('=');
+        args.push_back("--" + trim(line.substr(0, eq)));
+        if (eq != std::string::npos) args.push_back(trim(line.substr(eq + 1)));
+    }
+    return true;
+}
+
+static const char* const USAGE =
+    "OCRServer [options]\n"
+    "  --config FILE            read options from FILE (name = value lines)\n"
+    "  --address HOST:PORT      default 0.0.0.0:50051\n"
+    "  --workers N              OCR worker threads; default one per non-I/O core\n"
+    "  --queue-depth N          jobs queued before work is refused; default 25 per worker\n"
+    "  --io-cores N             cores kept for gRPC I/O; -1 (default) from the topology\n"
+    "  --pin-threads            pin workers and I/O threads to their cores\n"
+    "  --numa                   a worker group per NUMA node (implies --work-stealing)\n"
+    "  --min-workers N          elastic pool between N and --workers\n"
+    "  --target-wait-ms MS      elastic pool: p95 queue wait to stay under; default 500\n"
+    "  --async                  completion-queue server instead of the sync one\n"
+    "  --work-stealing          per-worker queues instead of one deadline-ordered queue\n"
+    "  --cache-mb N             result cache memory; 0 disables it; default 64\n"
+    "  --cache-dir DIR          keep cached results on disk under DIR too\n"
+    "  --cache-disk-mb N        bound on the disk cache; default 1024\n"
+    "  --engines N              Tesseract engines per model; default one per worker\n"
+    "  --warm-engines N         engines loaded per language at startup; default all\n"
+    "  --total-engines N        engines across all models; default twice --engines,\n"
+    "                           or all warm engines if that is more\n"
+    "  --tessdata DIR           where the .traineddata files are\n"
+    "  --languages L1,L2+L3     models loaded at startup; default eng\n"
+    "  --max-decode-mp MP       decode larger images at reduced scale; 0: never; default 16\n"
+    "  --target-dpi DPI         rescale to this resolution; 0: never; default 300\n"
+    "  --preprocess STAGES      any of denoise,binarize,deskew,crop\n"
+    "  --sauvola-window PX      binarize window, odd; default 31\n"
+    "  --sauvola-k K            binarize sensitivity; default 0.34\n"
+    "  --tile-min-mp MP         split pages this large across workers; 0 (default): never\n"
+    "  --log-level LEVEL        debug, info, warn, error or off; default info\n";
+
+// Throws UsageError for anything it does not understand, so a typo in a
+// flag or a config file stops the server instead of being ignored.
+static ServerOptions parse_options(std::vector<std::string> argList) {
+    ServerOptions options;
+    ArgReader args(std::move(argList));
+    while (args.next()) {
+        const std::string& arg = args.flag();
+        if (arg == "--config") args.value(); // already read
+        else if (arg == "--address") options.address = args.value();
+        else if (arg == "--workers") options.workers = args.count();
+        else if (arg == "--queue-depth") options.queueDepth = args.count();
+        else if (arg == "--io-cores") options.ioCores = static_cast<int>(args.integer(-1, 4096));
+        else if (arg == "--pin-threads") options.pinThreads = true;
+        else if (arg == "--numa") options.numa = true;
+        else if (arg == "--min-workers") options.minWorkers = args.count();
+        else if (arg == "--target-wait-ms") options.targetQueueWaitMs = args.number(1.0, 3.6e6);
+        else if (arg == "--async") options.asyncMode = true;
+        else if (arg == "--work-stealing") options.scheduling = PoolScheduling::WorkStealing;
+        else if (arg == "--cache-mb") options.cacheMb = args.count();
+        else if (arg == "--cache-dir") options.cacheDir = args.value();
+        else if (arg == "--cache-disk-mb") options.cacheDiskMb = args.count();
+        else if (arg == "--engines") options.engines = args.count();
+        else if (arg == "--warm-engines") options.warmEngines = args.count();
+        else if (arg == "--total-engines") options.totalEngines = args.count();
+        else if (arg == "--tessdata") options.tessdataDir = args.value();
+        else if (arg == "--languages") {
+            const std::string& list = args.value();
+            options.languages = split_list(list);
+            if (options.languages.empty()) args.invalid(list, "a list of languages");
+        }
+        else if (arg == "--max-decode-mp") options.maxDecodeMegapixels = args.number(0.0, 1e4);
+        else if (arg == "--target-dpi") options.targetDpi = static_cast<int>(args.integer(0, 4800));
+        else if (arg == "--preprocess") {
+            // e.g. "denoise,binarize,deskew,crop"
+            const std::string& list = args.value();
+            for (const auto& stage : split_list(list)) {
+                if (stage == "denoise") options.preprocess.denoise = true;
+                else if (stage == "binarize") options.preprocess.binarize = true;
+                else if (stage == "deskew") options.preprocess.deskew = true;
+                else if (stage == "crop") options.preprocess.cropBorders = true;
+                else args.invalid(list, "stages from denoise,binarize,deskew,crop");
+            }
+            // Both work on the binarized page
+            if (options.preprocess.deskew || options.preprocess.cropBorders) {
+                options.preprocess.binarize = true;
+            }
+        }
+        else if (arg == "--sauvola-window") {
+            const long long window = args.integer(3, 1001);
+            if (window % 2 == 0) args.invalid(std::to_string(window), "an odd number of pixels");
+            options.preprocess.sauvolaWindow = static_cast<int>(window);
+        }
+        else if (arg == "--sauvola-k") options.preprocess.sauvolaK = args.number(0.0, 1.0);
+        else if (arg == "--tile-min-mp") options.tileMinMegapixels = args.number(0.0, 1e4);
+        else if (arg == "--log-level") {
+            const std::string& level = args.value();
+            if (!parse_log_level(level, options.logLevel)) {
+                args.invalid(level, "debug, info, warn, error or off");
+            }
+        }
+        else args.unknown();
+    }
+    return options;
+}
+
+int main(int argc, char* argv[]) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            std::cout << USAGE;
+            return 0;
+        }
+    }
+
+    // Config file settings go first so the command line overrides them
+    std::vector<std::string> args;
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (std::string(argv[i]) != "--config") continue;
+        if (!read_config_file(argv[i + 1], args)) {
+            LOG_ERROR("cannot read config file").kv("path", argv[i + 1]);
+            flush_log();
+            return 1;
+        }
+    }
+    args.insert(args.end(), argv + 1, argv + argc);
+
+    ServerOptions options;
+    try {
+        options = parse_options(std::move(args));
+    }
+    catch (const UsageError& ex) {
+        std::cerr << "OCRServer: " << ex.what() << "\n\n" << USAGE;
+        return 2;
+    }
+    set_log_level(options.logLevel);
+
+    // E.g. a --languages entry that is not installed
+    try {
+        RunServer(options);
+    }
+    catch (const std::exception& ex) {
+        LOG_ERROR("server stopped").kv("error", ex.what());
+        flush_log();
+        return 1;
+    }
+    flush_log();
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,285 @@
+#include "TessEnginePool.h"
+#include "CancellationToken.h"
+#include "CpuTopology.h"
+#include "Logger.h"
+
+#include <tesseract/baseapi.h>
+
+#include <algorithm>
+#include <exception>
+#include <iterator>
+#include <stdexcept>
+#include <thread>
+
+TessEnginePool::Lease::Lease(TessEnginePool* pool,
+    std::unique_ptr<tesseract::TessBaseAPI> engine, int node)
+    : pool_(pool), engine_(std::move(engine)), node_(node) {
+}
+
+TessEnginePool::Lease::Lease(Lease&& other) noexcept
+    : pool_(other.pool_), engine_(std::move(other.engine_)), node_(other.node_) {
+}
+
+TessEnginePool::Lease::~Lease() {
+    if (engine_) pool_->checkin(std::move(engine_), node_);
+}
+
+TessEnginePool::TessEnginePool(std::size_t maxEngines, Factory factory, std::string name)
+    : maxEngines_(maxEngines == 0 ? 1 : maxEngines), factory_(std::move(factory)),
+    name_(std::move(name)) {
+}
+
+TessEnginePool::~TessEnginePool() {
+    for (auto& idle : idle_) {
+        idle.engine->End();
+    }
+}
+
+void TessEnginePool::warmUp(std::size_t count) {
+    std::size_t toCreate = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        count = std::min(count, maxEngines_);
+        if (count > created_) toCreate = count - created_;
+        created_ += toCreate;
+    }
+    if (toCreate == 0) return;
+
+    const auto start = std::chrono::steady_clock::now();
+
+    // Model loading is mostly file I/O and parsing, so the engines are
+    // initialized side by side, each loader on the node its engine is for
+    const CpuTopology& topology = system_topology();
+    const std::vector<int> nodes = topology.nodeIds();
+    std::vector<std::unique_ptr<tesseract::TessBaseAPI>> engines(toCreate);
+    std::vector<int> engineNodes(toCreate, 0);
+    std::vector<std::thread> loaders;
+    std::mutex errorMutex;
+    std::exception_ptr error;
+    for (std::size_t i = 0; i < toCreate; ++i) {
+        if (nodes.size() > 1) engineNodes[i] = nodes[i % nodes.size()];
+        loaders.emplace_back([&, i] {
+            try {
+                if (nodes.size() > 1) pin_current_thread(topology.nodeCpus(engineNodes[i]));
+                engines[i] = factory_();
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (!error) error = std::current_exception();
+            }
+            });
+    }
+    for (auto& t : loaders) t.join();
+
+    std::size_t ready = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (std::size_t i = 0; i < toCreate; ++i) {
+            if (engines[i]) {
+                idle_.push_back(IdleEngine{ std::move(engines[i]), engineNodes[i] });
+                ++ready;
+            }
+            else {
+                --created_;
+            }
+        }
+    }
+    cv_.notify_all();
+
+    LOG_INFO("engines warmed up").kv("pool", name_).kv("ready", ready)
+        .kv("ms", std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start).count())
+        .kv("max", maxEngines_);
+
+    if (error) std::rethrow_exception(error);
+}
+
+TessEnginePool::Lease TessEnginePool::checkout(const CancellationToken* cancel) {
+    // How often a waiting caller re-checks its token
+    const auto POLL_INTERVAL = std::chrono::milliseconds(100);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (idle_.empty() && created_ >= maxEngines_) {
+        if (cancel && cancel->isCancelled()) {
+            throw OcrCancelledError("OCR cancelled while waiting for an engine");
+        }
+        cv_.wait_for(lock, POLL_INTERVAL);
+    }
+
+    // An idle engine from this thread's node; failing that a new one,
+    // loaded here into this node's memory, while below the limit; failing
+    // that whichever is idle.
+    const int node = current_numa_node();
+    auto local = std::find_if(idle_.rbegin(), idle_.rend(),
+        [node](const IdleEngine& idle) { return idle.node == node; });
+    if (local == idle_.rend() && created_ >= maxEngines_) local = idle_.rbegin();
+    if (local != idle_.rend()) {
+        IdleEngine taken = std::move(*local);
+        idle_.erase(std::next(local).base());
+        return Lease(this, std::move(taken.engine), taken.node);
+    }
+
+    // Below the limit and nothing idle here: grow. The model is loaded
+    // outside the lock so other checkouts and checkins are not held up by it.
+    ++created_;
+    lock.unlock();
+
+    std::unique_ptr<tesseract::TessBaseAPI> engine;
+    try {
+        engine = factory_();
+    }
+    catch (...) {
+        lock.lock();
+        --created_;
+        lock.unlock();
+        cv_.notify_one();
+        throw;
+    }
+    LOG_INFO("engine created on demand").kv("pool", name_).kv("created", created())
+        .kv("max", maxEngines_).kv("numa_node", node);
+    return Lease(this, std::move(engine), node);
+}
+
+std::size_t TessEnginePool::trim(std::size_t keep) {
+    std::vector<std::unique_ptr<tesseract::TessBaseAPI>> ended;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        while (created_ > keep && !idle_.empty()) {
+            ended.push_back(std::move(idle_.back().engine));
+            idle_.pop_back();
+            --created_;
+        }
+    }
+    if (ended.empty()) return 0;
+
+    // Unloading is slow enough to keep out of the lock
+    for (auto& engine : ended) {
+        engine->End();
+    }
+    LOG_INFO("idle engines released").kv("pool", name_).kv("released", ended.size())
+        .kv("created", created());
+    return ended.size();
+}
+
+std::size_t TessEnginePool::created() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return created_;
+}
+
+std::size_t TessEnginePool::idle() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return idle_.size();
+}
+
+void TessEnginePool::checkin(std::unique_ptr<tesseract::TessBaseAPI> engine, int node) {
+    // Frees the last image and its results; the model stays loaded
+    engine->Clear();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        idle_.push_back(IdleEngine{ std::move(engine), node });
+    }
+    cv_.notify_one();
+}
+
+TessEngineRegistry::TessEngineRegistry(std::size_t maxEnginesPerModel, std::size_t maxEngines,
+    Factory factory)
+    : maxEnginesPerModel_(maxEnginesPerModel),
+    maxEngines_(maxEngines > 0 ? maxEngines : 2 * std::max<std::size_t>(1, maxEnginesPerModel)),
+    factory_(std::move(factory)) {
+}
+
+void TessEngineRegistry::warmUp(const std::string& language, int engineMode,
+    std::size_t count) {
+    pool(language, engineMode).warmUp(count);
+}
+
+TessEnginePool& TessEngineRegistry::pool(const std::string& language, int engineMode) {
+    const ModelKey model(language, engineMode);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto failed = failed_.find(model);
+    if (failed != failed_.end()) {
+        throw std::runtime_error(failed->second);
+    }
+
+    auto it = pools_.find(model);
+    if (it == pools_.end()) {
+        if (pools_.size() + failed_.size() >= MAX_MODELS) {
+            throw std::runtime_error("Too many OCR models in use (" + std::to_string(MAX_MODELS)
+                + "); cannot load '" + language + "'");
+        }
+        // Engines are only created on warmUp() or checkout, outside this lock
+        Model entry;
+        entry.pool = std::make_unique<TessEnginePool>(maxEnginesPerModel_,
+            [this, model] { return create(model); },
+            "Tesseract engines " + language + "/oem" + std::to_string(engineMode));
+        it = pools_.emplace(model, std::move(entry)).first;
+    }
+    it->second.lastUse = ++useClock_;
+    return *it->second.pool;
+}
+
+std::vector<std::pair<std::string, int>> TessEngineRegistry::models() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<std::pair<std::string, int>> out;
+    for (const auto& entry : pools_) {
+        if (entry.second.pool->created() > 0) out.push_back(entry.first);
+    }
+    return out;
+}
+
+std::size_t TessEngineRegistry::trim(std::size_t keepPerModel) {
+    std::vector<TessEnginePool*> pools;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& entry : pools_) pools.push_back(entry.second.pool.get());
+    }
+
+    std::size_t ended = 0;
+    for (TessEnginePool* pool : pools) ended += pool->trim(keepPerModel);
+    return ended;
+}
+
+std::unique_ptr<tesseract::TessBaseAPI> TessEngineRegistry::create(const ModelKey& model) {
+    makeRoom(model);
+    try {
+        return factory_(model.first, model.second);
+    }
+    catch (const ModelLoadError& ex) {
+        // Missing traineddata does not fix itself; later requests for this
+        // model fail fast instead of reading the disk again
+        std::lock_guard<std::mutex> lock(mutex_);
+        failed_.emplace(model, ex.what());
+        throw;
+    }
+}
+
+// Called with the new engine already counted by its pool. Ends idle
+// engines, least recently used model first, until the total is back
+// within maxEngines_. Unloading happens outside the lock.
+void TessEngineRegistry::makeRoom(const ModelKey& model) {
+    for (;;) {
+        TessEnginePool* victim = nullptr;
+        std::size_t excess = 0;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            std::size_t total = 0;
+            const Model* oldest = nullptr;
+            for (const auto& entry : pools_) {
+                total += entry.second.pool->created();
+                if (entry.second.pool->idle() == 0) continue;
+                if (!oldest || entry.second.lastUse < oldest->lastUse) oldest = &entry.second;
+            }
+            if (total <= maxEngines_) return;
+            if (!oldest) {
+                throw std::runtime_error("All " + std::to_string(maxEngines_)
+                    + " Tesseract engines are in use; cannot load '" + model.first + "' now");
+            }
+            victim = oldest->pool.get();
+            excess = total - maxEngines_;
+        }
+
+        const std::size_t created = victim->created();
+        victim->trim(created - std::min(excess, created));
+    }
+}
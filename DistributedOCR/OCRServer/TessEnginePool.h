@@ -0,0 +1,159 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+class CancellationToken;
+
+namespace tesseract {
+class TessBaseAPI;
+}
+
+// Initialized Tesseract engines shared by every thread that runs OCR
+// (pool workers, tile regions, gRPC threads). An engine is checked out for
+// one recognition and checked back in afterwards, cleared of that image's
+// results but keeping its loaded model. Engines are created up front by
+// warmUp() or on demand, up to maxEngines; checkout() waits while all of
+// them are in use. Thread-safe.
+//
+// On NUMA machines each engine belongs to the node it was loaded on, and
+// checkout() prefers one from the caller's node, loading a new one there
+// rather than borrowing another node's while below maxEngines, so a
+// worker's model reads stay in local memory.
+class TessEnginePool {
+public:
+    using Factory = std::function<std::unique_ptr<tesseract::TessBaseAPI>()>;
+
+    // Exclusive use of one engine; returns it to the pool when destroyed.
+    class Lease {
+    public:
+        Lease(Lease&& other) noexcept;
+        Lease& operator=(Lease&&) = delete;
+        ~Lease();
+
+        tesseract::TessBaseAPI* operator->() const { return engine_.get(); }
+        tesseract::TessBaseAPI* get() const { return engine_.get(); }
+
+    private:
+        friend class TessEnginePool;
+        Lease(TessEnginePool* pool, std::unique_ptr<tesseract::TessBaseAPI> engine, int node);
+
+        TessEnginePool* pool_;
+        std::unique_ptr<tesseract::TessBaseAPI> engine_;
+        int node_;
+    };
+
+    // name labels the pool's log lines.
+    TessEnginePool(std::size_t maxEngines, Factory factory,
+        std::string name = "Tesseract engines");
+    ~TessEnginePool();
+
+    // Creates engines until count exist (at most maxEngines), loading their
+    // models in parallel, so the first jobs do not pay for it. They are
+    // spread evenly over the NUMA nodes.
+    void warmUp(std::size_t count);
+
+    // Throws OcrCancelledError if cancel fires while waiting for an engine.
+    Lease checkout(const CancellationToken* cancel = nullptr);
+
+    // Ends idle engines until at most keep exist, freeing their models;
+    // engines in use are left alone. checkout() creates engines again as
+    // needed. Returns how many were ended.
+    std::size_t trim(std::size_t keep);
+
+    std::size_t maxEngines() const { return maxEngines_; }
+    std::size_t created() const;
+    std::size_t idle() const;
+
+private:
+    struct IdleEngine {
+        std::unique_ptr<tesseract::TessBaseAPI> engine;
+        int node; // NUMA node its memory was allocated on
+    };
+
+    void checkin(std::unique_ptr<tesseract::TessBaseAPI> engine, int node);
+
+    const std::size_t maxEngines_;
+    Factory factory_;
+    const std::string name_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_; // signalled when an engine is checked in
+    std::vector<IdleEngine> idle_;
+    std::size_t created_ = 0; // including engines still being initialized
+};
+
+// Thrown by a TessEngineRegistry factory when a model's traineddata is
+// missing or cannot be loaded.
+class ModelLoadError : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+// One TessEnginePool per model, a model being a language set ("eng",
+// "eng+deu") loaded for one engine mode. Models are added by warmUp() or
+// on first use, up to MAX_MODELS; language sets come from requests, so
+// callers should check them against the installed traineddata first. A
+// model whose factory throws ModelLoadError is remembered and not retried;
+// other failures (out of memory, say) are passed on and the next request
+// tries again.
+// All models together hold at most maxEngines engines. When a new engine
+// would go over that, idle engines of the least recently used models are
+// ended first; if every engine is busy, creating it fails (and is not
+// remembered).
+// Page segmentation is not part of the model: it is switched per image on
+// any engine of the right model. Thread-safe.
+class TessEngineRegistry {
+public:
+    static const std::size_t MAX_MODELS = 64;
+
+    using Factory = std::function<std::unique_ptr<tesseract::TessBaseAPI>(
+        const std::string& language, int engineMode)>;
+
+    // maxEngines 0: twice maxEnginesPerModel.
+    TessEngineRegistry(std::size_t maxEnginesPerModel, std::size_t maxEngines, Factory factory);
+
+    void warmUp(const std::string& language, int engineMode, std::size_t count);
+
+    // Throws std::runtime_error if the model cannot be loaded or MAX_MODELS
+    // are in use already.
+    TessEnginePool& pool(const std::string& language, int engineMode);
+
+    // Models loaded so far, as (language, engine mode).
+    std::vector<std::pair<std::string, int>> models() const;
+
+    // TessEnginePool::trim() on every model's pool.
+    std::size_t trim(std::size_t keepPerModel);
+
+    std::size_t maxEngines() const { return maxEngines_; }
+
+private:
+    using ModelKey = std::pair<std::string, int>;
+
+    struct Model {
+        std::unique_ptr<TessEnginePool> pool;
+        std::uint64_t lastUse = 0; // useClock_ when pool() last returned it
+    };
+
+    std::unique_ptr<tesseract::TessBaseAPI> create(const ModelKey& model);
+    void makeRoom(const ModelKey& model);
+
+    const std::size_t maxEnginesPerModel_;
+    const std::size_t maxEngines_;
+    Factory factory_;
+
+    mutable std::mutex mutex_;
+    std::map<ModelKey, Model> pools_; // never removed, so usable outside the lock
+    std::map<ModelKey, std::string> failed_; // why each bad model failed
+    std::uint64_t useClock_ = 0;
+};
@@ -0,0 +1,234 @@
+#include "WorkStealingScheduler.h"
+#include "CpuTopology.h"
+
+#include <algorithm>
+#include <map>
+
+// Which scheduler and deque the current thread works for, if any.
+static thread_local const WorkStealingScheduler* tls_scheduler = nullptr;
+static thread_local int tls_worker = -1;
+
+WorkStealingScheduler::WorkStealingScheduler(std::size_t numThreads,
+    std::function<void(std::size_t)> onThreadStart, std::vector<int> workerNodes) {
+    if (numThreads == 0) numThreads = 1;
+
+    if (workerNodes.size() == numThreads) {
+        std::map<int, std::vector<std::size_t>> byNode;
+        for (std::size_t i = 0; i < numThreads; ++i) byNode[workerNodes[i]].push_back(i);
+        if (byNode.size() > 1) {
+            for (auto& node : byNode) groups_.push_back(NodeGroup{ node.first, std::move(node.second) });
+            workerNode_ = std::move(workerNodes);
+        }
+    }
+
+    queues_.reserve(numThreads);
+    for (std::size_t i = 0; i < numThreads; ++i) {
+        queues_.push_back(std::make_unique<WorkerQueue>());
+    }
+    active_ = numThreads;
+
+    threads_.reserve(numThreads);
+    for (std::size_t i = 0; i < numThreads; ++i) {
+        threads_.emplace_back([this, i, onThreadStart] {
+            if (onThreadStart) onThreadStart(i);
+            workerLoop(i);
+        });
+    }
+}
+
+WorkStealingScheduler::~WorkStealingScheduler() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        stopping_ = true;
+    }
+    sleepCv_.notify_all();
+    parkCv_.notify_all();
+
+    for (auto& t : threads_) {
+        if (t.joinable()) t.join();
+    }
+}
+
+int WorkStealingScheduler::currentWorker() {
+    return tls_worker;
+}
+
+void WorkStealingScheduler::setActiveWorkers(std::size_t count) {
+    count = std::clamp<std::size_t>(count, 1, queues_.size());
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        active_ = count;
+    }
+    parkCv_.notify_all();
+}
+
+const WorkStealingScheduler::NodeGroup* WorkStealingScheduler::callerGroup() const {
+    if (groups_.empty()) return nullptr;
+    const int node = current_numa_node();
+    for (const NodeGroup& group : groups_) {
+        if (group.node == node) return &group;
+    }
+    return nullptr;
+}
+
+std::size_t WorkStealingScheduler::activeIn(const NodeGroup& group, std::size_t active) {
+    // Workers below active are the active ones, and group.workers is sorted
+    return static_cast<std::size_t>(std::lower_bound(group.workers.begin(),
+        group.workers.end(), active) - group.workers.begin());
+}
+
+std::size_t WorkStealingScheduler::pickQueue() {
+    const std::size_t active = active_.load();
+    const std::size_t turn = nextQueue_.fetch_add(1);
+    if (const NodeGroup* group = callerGroup()) {
+        const std::size_t count = activeIn(*group, active);
+        if (count > 0) return group->workers[turn % count];
+    }
+    return turn % active;
+}
+
+void WorkStealingScheduler::submit(Task task) {
+    // A task spawned by one of our workers stays local; anything else is
+    // dealt out round-robin, on the submitter's node if it has workers.
+    const std::size_t index = (tls_scheduler == this)
+        ? static_cast<std::size_t>(tls_worker)
+        : pickQueue();
+
+    // Counted before it becomes visible, so a worker can never take it
+    // while pending_ is still zero
+    pending_.fetch_add(1);
+    {
+        std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+        queues_[index]->tasks.push_back(std::move(task));
+    }
+    wakeWorkers(1);
+}
+
+void WorkStealingScheduler::submitBatch(std::vector<Task> tasks) {
+    if (tasks.empty()) return;
+
+    const std::size_t active = active_.load();
+    std::vector<std::size_t> targets;
+    if (const NodeGroup* group = callerGroup()) {
+        targets.assign(group->workers.begin(), group->workers.begin() + activeIn(*group, active));
+    }
+    if (targets.empty()) {
+        for (std::size_t i = 0; i < active; ++i) targets.push_back(i);
+    }
+
+    const std::size_t count = tasks.size();
+    const std::size_t numQueues = targets.size();
+    const std::size_t slice = (count + numQueues - 1) / numQueues;
+    const std::size_t first = nextQueue_.fetch_add(1);
+
+    pending_.fetch_add(count);
+
+    std::size_t next = 0;
+    for (std::size_t q = 0; q < numQueues && next < count; ++q) {
+        const std::size_t end = std::min(count, next + slice);
+        WorkerQueue& queue = *queues_[targets[(first + q) % numQueues]];
+
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        for (; next < end; ++next) {
+            queue.tasks.push_back(std::move(tasks[next]));
+        }
+    }
+
+    wakeWorkers(count);
+}
+
+void WorkStealingScheduler::wakeWorkers(std::size_t count) {
+    // pending_ was raised before this load; a worker that is about to sleep
+    // raises sleepers_ before it re-checks pending_, so one of the two
+    // always sees the other.
+    if (sleepers_.load() == 0) return;
+
+    {
+        // Taken so the notify cannot slip in between a worker's check of
+        // pending_ and its wait.
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+    }
+    if (count == 1) {
+        sleepCv_.notify_one();
+    }
+    else {
+        sleepCv_.notify_all();
+    }
+}
+
+bool WorkStealingScheduler::popLocal(std::size_t index, Task& out) {
+    WorkerQueue& queue = *queues_[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) return false;
+
+    out = std::move(queue.tasks.front());
+    queue.tasks.pop_front();
+    return true;
+}
+
+bool WorkStealingScheduler::steal(std::size_t thief, Task& out) {
+    const std::size_t numQueues = queues_.size();
+
+    // With NUMA groups, the thief's own node first and the others only
+    // when that finds nothing
+    const int passes = workerNode_.empty() ? 1 : 2;
+    for (int pass = 0; pass < passes; ++pass) {
+        for (std::size_t k = 1; k < numQueues; ++k) {
+            const std::size_t v = (thief + k) % numQueues;
+            if (passes == 2 && (workerNode_[v] == workerNode_[thief]) != (pass == 0)) continue;
+            WorkerQueue& victim = *queues_[v];
+
+            // Skip a victim that is busy rather than queue up behind it
+            std::unique_lock<std::mutex> lock(victim.mutex, std::try_to_lock);
+            if (!lock.owns_lock() || victim.tasks.empty()) continue;
+
+            out = std::move(victim.tasks.back());
+            victim.tasks.pop_back();
+            return true;
+        }
+    }
+    return false;
+}
+
+void WorkStealingScheduler::workerLoop(std::size_t index) {
+    tls_scheduler = this;
+    tls_worker = static_cast<int>(index);
+
+    while (true) {
+        if (index >= active_.load() && !stopping_) {
+            std::unique_lock<std::mutex> lock(sleepMutex_);
+            // This thread may have taken a wake-up meant for an active one
+            if (pending_.load() > 0) sleepCv_.notify_one();
+            parkCv_.wait(lock, [this, index] {
+                return stopping_ || index < active_.load();
+                });
+            continue;
+        }
+
+        Task task;
+        if (popLocal(index, task) || steal(index, task)) {
+            pending_.fetch_sub(1);
+            task();
+            continue;
+        }
+
+        // A failed try_lock can make steal() miss work, and a counted task
+        // may not be in its deque yet, so only sleep once nothing is
+        // pending anywhere.
+        if (pending_.load() > 0) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        if (stopping_) {
+            return; // everything queued has been taken
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex_);
+        sleepers_.fetch_add(1);
+        sleepCv_.wait(lock, [this] {
+            return stopping_ || pending_.load() > 0;
+            });
+        sleepers_.fetch_sub(1);
+    }
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of threads, each with its own task deque. A worker runs tasks
+// from the front of its own deque and, when that is empty, steals from the
+// back of another worker's. Submitters and workers only ever lock one deque
+// at a time, so there is no single lock every thread contends on, and idle
+// workers are only woken when they actually have to sleep.
+//
+// Tasks submitted from inside a task go to the calling worker's own deque.
+// Tasks still queued at destruction are run before the threads exit.
+// onThreadStart, if set, runs first on each worker thread with its index.
+//
+// workerNodes, if given, is the NUMA node each worker runs on (see
+// CpuTopology; pinning them there is up to onThreadStart). Workers then form
+// one group per node: tasks submitted from outside go to the workers of the
+// node the submitting thread is running on, so the data it just received
+// stays in that node's memory, and a worker takes work from another node
+// only when its own node has none left.
+class WorkStealingScheduler {
+public:
+    using Task = std::function<void()>;
+
+    explicit WorkStealingScheduler(std::size_t numThreads,
+        std::function<void(std::size_t)> onThreadStart = nullptr,
+        std::vector<int> workerNodes = {});
+    ~WorkStealingScheduler();
+
+    WorkStealingScheduler(const WorkStealingScheduler&) = delete;
+    WorkStealingScheduler& operator=(const WorkStealingScheduler&) = delete;
+
+    void submit(Task task);
+
+    // Spreads the tasks over all deques (of the caller's node), in
+    // contiguous slices so a worker's share stays in submission order,
+    // taking each deque's lock once.
+    void submitBatch(std::vector<Task> tasks);
+
+    // Workers taking new tasks; the others are parked (see setActiveWorkers).
+    std::size_t workerCount() const { return active_.load(); }
+    std::size_t maxWorkers() const { return queues_.size(); }
+
+    // Lets only workers 0 .. count - 1 run tasks (count is clamped to
+    // 1 .. maxWorkers()). Outside submissions go to their deques only; a
+    // parked worker finishes the task it is running and then sleeps until
+    // it is activated again, and whatever is left in its deque is stolen.
+    void setActiveWorkers(std::size_t count);
+
+    // Index of the calling worker thread, or -1 off the scheduler's threads.
+    static int currentWorker();
+
+private:
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    // The workers on one NUMA node, in index order.
+    struct NodeGroup {
+        int node = 0;
+        std::vector<std::size_t> workers;
+    };
+
+    const NodeGroup* callerGroup() const;
+    static std::size_t activeIn(const NodeGroup& group, std::size_t active);
+    std::size_t pickQueue();
+
+    void workerLoop(std::size_t index);
+    bool popLocal(std::size_t index, Task& out);
+    bool steal(std::size_t thief, Task& out);
+    void wakeWorkers(std::size_t count);
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues_;
+    std::vector<std::thread> threads_;
+
+    // Both empty unless the workers span more than one NUMA node
+    std::vector<int> workerNode_;
+    std::vector<NodeGroup> groups_;
+
+    // Submitted but not yet taken by a worker; workers sleep only while
+    // this is zero.
+    std::atomic<std::size_t> pending_{ 0 };
+    std::atomic<std::size_t> sleepers_{ 0 };
+    std::atomic<std::size_t> nextQueue_{ 0 }; // round-robin for outside submits
+    std::atomic<std::size_t> active_{ 0 };
+    std::atomic<bool> stopping_{ false };
+
+    std::mutex sleepMutex_;
+    std::condition_variable sleepCv_;
+    std::condition_variable parkCv_; // parked workers, apart from idle ones
+};
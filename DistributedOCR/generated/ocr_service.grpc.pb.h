@@ -1,242 +0,0 @@
-// Generated by the gRPC C++ plugin.
-// If you make any local change, they will be lost.
-// source: ocr_service.proto
-#ifndef GRPC_ocr_5fservice_2eproto__INCLUDED
-#define GRPC_ocr_5fservice_2eproto__INCLUDED
-
-#include "ocr_service.pb.h"
-
-#include <functional>
-#include <grpcpp/generic/async_generic_service.h>
-#include <grpcpp/support/async_stream.h>
-#include <grpcpp/support/async_unary_call.h>
-#include <grpcpp/support/client_callback.h>
-#include <grpcpp/client_context.h>
-#include <grpcpp/completion_queue.h>
-#include <grpcpp/support/message_allocator.h>
-#include <grpcpp/support/method_handler.h>
-#include <grpcpp/impl/proto_utils.h>
-#include <grpcpp/impl/rpc_method.h>
-#include <grpcpp/support/server_callback.h>
-#include <grpcpp/impl/server_callback_handlers.h>
-#include <grpcpp/server_context.h>
-#include <grpcpp/impl/service_type.h>
-#include <grpcpp/support/status.h>
-#include <grpcpp/support/stub_options.h>
-#include <grpcpp/support/sync_stream.h>
-#include <grpcpp/ports_def.inc>
-
-namespace ocr {
-
-class OCRService final {
- public:
-  static constexpr char const* service_full_name() {
-    return "ocr.OCRService";
-  }
-  class StubInterface {
-   public:
-    virtual ~StubInterface() {}
-    virtual ::grpc::Status ProcessBatch(::grpc::ClientContext* context, const ::ocr::BatchRequest& request, ::ocr::BatchResponse* response) = 0;
-    std::unique_ptr< ::grpc::ClientAsyncResponseReaderInterface< ::ocr::BatchResponse>> AsyncProcessBatch(::grpc::ClientContext* context, const ::ocr::BatchRequest& request, ::grpc::CompletionQueue* cq) {
-      return std::unique_ptr< ::grpc::ClientAsyncResponseReaderInterface< ::ocr::BatchResponse>>(AsyncProcessBatchRaw(context, request, cq));
-    }
-    std::unique_ptr< ::grpc::ClientAsyncResponseReaderInterface< ::ocr::BatchResponse>> PrepareAsyncProcessBatch(::grpc::ClientContext* context, const ::ocr::BatchRequest& request, ::grpc::CompletionQueue* cq) {
-      return std::unique_ptr< ::grpc::ClientAsyncResponseReaderInterface< ::ocr::BatchResponse>>(PrepareAsyncProcessBatchRaw(context, request, cq));
-    }
-    class async_interface {
-     public:
-      virtual ~async_interface() {}
-      virtual void ProcessBatch(::grpc::ClientContext* context, const ::ocr::BatchRequest* request, ::ocr::BatchResponse* response, std::function<void(::grpc::Status)>) = 0;
-      virtual void ProcessBatch(::grpc::ClientContext* context, const ::ocr::BatchRequest* request, ::ocr::BatchResponse* response, ::grpc::ClientUnaryReactor* reactor) = 0;
-    };
-    typedef class async_interface experimental_async_interface;
-    virtual class async_interface* async() { return nullptr; }
-    class async_interface* experimental_async() { return async(); }
-   private:
-    virtual ::grpc::ClientAsyncResponseReaderInterface< ::ocr::BatchResponse>* AsyncProcessBatchRaw(::grpc::ClientContext* context, const ::ocr::BatchRequest& request, ::grpc::CompletionQueue* cq) = 0;
-    virtual ::grpc::ClientAsyncResponseReaderInterface< ::ocr::BatchResponse>* PrepareAsyncProcessBatchRaw(::grpc::ClientContext* context, const ::ocr::BatchRequest& request, ::grpc::CompletionQueue* cq) = 0;
-  };
-  class Stub final : public StubInterface {
-   public:
-    Stub(const std::shared_ptr< ::grpc::ChannelInterface>& channel, const ::grpc::StubOptions& options = ::grpc::StubOptions());
-    ::grpc::Status ProcessBatch(::grpc::ClientContext* context, const ::ocr::BatchRequest& request, ::ocr::BatchResponse* response) override;
-    std::unique_ptr< ::grpc::ClientAsyncResponseReader< ::ocr::BatchResponse>> AsyncProcessBatch(::grpc::ClientContext* context, const ::ocr::BatchRequest& request, ::grpc::CompletionQueue* cq) {
-      return std::unique_ptr< ::grpc::ClientAsyncResponseReader< ::ocr::BatchResponse>>(AsyncProcessBatchRaw(context, request, cq));
-    }
-    std::unique_ptr< ::grpc::ClientAsyncResponseReader< ::ocr::BatchResponse>> PrepareAsyncProcessBatch(::grpc::ClientContext* context, const ::ocr::BatchRequest& request, ::grpc::CompletionQueue* cq) {
-      return std::unique_ptr< ::grpc::ClientAsyncResponseReader< ::ocr::BatchResponse>>(PrepareAsyncProcessBatchRaw(context, request, cq));
-    }
-    class async final :
-      public StubInterface::async_interface {
-     public:
-      void ProcessBatch(::grpc::ClientContext* context, const ::ocr::BatchRequest* request, ::ocr::BatchResponse* response, std::function<void(::grpc::Status)>) override;
-      void ProcessBatch(::grpc::ClientContext* context, const ::ocr::BatchRequest* request, ::ocr::BatchResponse* response, ::grpc::ClientUnaryReactor* reactor) override;
-     private:
-      friend class Stub;
-      explicit async(Stub* stub): stub_(stub) { }
-      Stub* stub() { return stub_; }
-      Stub* stub_;
-    };
-    class async* async() override { return &async_stub_; }
-
-   private:
-    std::shared_ptr< ::grpc::ChannelInterface> channel_;
-    class async async_stub_{this};
-    ::grpc::ClientAsyncResponseReader< ::ocr::BatchResponse>* AsyncProcessBatchRaw(::grpc::ClientContext* context, const ::ocr::BatchRequest& request, ::grpc::CompletionQueue* cq) override;
-    ::grpc::ClientAsyncResponseReader< ::ocr::BatchResponse>* PrepareAsyncProcessBatchRaw(::grpc::ClientContext* context, const ::ocr::BatchRequest& request, ::grpc::CompletionQueue* cq) override;
-    const ::grpc::internal::RpcMethod rpcmethod_ProcessBatch_;
-  };
-  static std::unique_ptr<Stub> NewStub(const std::shared_ptr< ::grpc::ChannelInterface>& channel, const ::grpc::StubOptions& options = ::grpc::StubOptions());
-
-  class Service : public ::grpc::Service {
-   public:
-    Service();
-    virtual ~Service();
-    virtual ::grpc::Status ProcessBatch(::grpc::ServerContext* context, const ::ocr::BatchRequest* request, ::ocr::BatchResponse* response);
-  };
-  template <class BaseClass>
-  class WithAsyncMethod_ProcessBatch : public BaseClass {
-   private:
-    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
-   public:
-    WithAsyncMethod_ProcessBatch() {
-      ::grpc::Service::MarkMethodAsync(0);
-    }
-    ~WithAsyncMethod_ProcessBatch() override {
-      BaseClassMustBeDerivedFromService(this);
-    }
-    // disable synchronous version of this method
-    ::grpc::Status ProcessBatch(::grpc::ServerContext* /*context*/, const ::ocr::BatchRequest* /*request*/, ::ocr::BatchResponse* /*response*/) override {
-      abort();
-      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
-    }
-    void RequestProcessBatch(::grpc::ServerContext* context, ::ocr::BatchRequest* request, ::grpc::ServerAsyncResponseWriter< ::ocr::BatchResponse>* response, ::grpc::CompletionQueue* new_call_cq, ::grpc::ServerCompletionQueue* notification_cq, void *tag) {
-      ::grpc::Service::RequestAsyncUnary(0, context, request, response, new_call_cq, notification_cq, tag);
-    }
-  };
-  typedef WithAsyncMethod_ProcessBatch<Service > AsyncService;
-  template <class BaseClass>
-  class WithCallbackMethod_ProcessBatch : public BaseClass {
-   private:
-    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
-   public:
-    WithCallbackMethod_ProcessBatch() {
-      ::grpc::Service::MarkMethodCallback(0,
-          new ::grpc::internal::CallbackUnaryHandler< ::ocr::BatchRequest, ::ocr::BatchResponse>(
-            [this](
-                   ::grpc::CallbackServerContext* context, const ::ocr::BatchRequest* request, ::ocr::BatchResponse* response) { return this->ProcessBatch(context, request, response); }));}
-    void SetMessageAllocatorFor_ProcessBatch(
-        ::grpc::MessageAllocator< ::ocr::BatchRequest, ::ocr::BatchResponse>* allocator) {
-      ::grpc::internal::MethodHandler* const handler = ::grpc::Service::GetHandler(0);
-      static_cast<::grpc::internal::CallbackUnaryHandler< ::ocr::BatchRequest, ::ocr::BatchResponse>*>(handler)
-              ->SetMessageAllocator(allocator);
-    }
-    ~WithCallbackMethod_ProcessBatch() override {
-      BaseClassMustBeDerivedFromService(this);
-    }
-    // disable synchronous version of this method
-    ::grpc::Status ProcessBatch(::grpc::ServerContext* /*context*/, const ::ocr::BatchRequest* /*request*/, ::ocr::BatchResponse* /*response*/) override {
-      abort();
-      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
-    }
-    virtual ::grpc::ServerUnaryReactor* ProcessBatch(
-      ::grpc::CallbackServerContext* /*context*/, const ::ocr::BatchRequest* /*request*/, ::ocr::BatchResponse* /*response*/)  { return nullptr; }
-  };
-  typedef WithCallbackMethod_ProcessBatch<Service > CallbackService;
-  typedef CallbackService ExperimentalCallbackService;
-  template <class BaseClass>
-  class WithGenericMethod_ProcessBatch : public BaseClass {
-   private:
-    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
-   public:
-    WithGenericMethod_ProcessBatch() {
-      ::grpc::Service::MarkMethodGeneric(0);
-    }
-    ~WithGenericMethod_ProcessBatch() override {
-      BaseClassMustBeDerivedFromService(this);
-    }
-    // disable synchronous version of this method
-    ::grpc::Status ProcessBatch(::grpc::ServerContext* /*context*/, const ::ocr::BatchRequest* /*request*/, ::ocr::BatchResponse* /*response*/) override {
-      abort();
-      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
-    }
-  };
-  template <class BaseClass>
-  class WithRawMethod_ProcessBatch : public BaseClass {
-   private:
-    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
-   public:
-    WithRawMethod_ProcessBatch() {
-      ::grpc::Service::MarkMethodRaw(0);
-    }
-    ~WithRawMethod_ProcessBatch() override {
-      BaseClassMustBeDerivedFromService(this);
-    }
-    // disable synchronous version of this method
-    ::grpc::Status ProcessBatch(::grpc::ServerContext* /*context*/, const ::ocr::BatchRequest* /*request*/, ::ocr::BatchResponse* /*response*/) override {
-      abort();
-      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
-    }
-    void RequestProcessBatch(::grpc::ServerContext* context, ::grpc::ByteBuffer* request, ::grpc::ServerAsyncResponseWriter< ::grpc::ByteBuffer>* response, ::grpc::CompletionQueue* new_call_cq, ::grpc::ServerCompletionQueue* notification_cq, void *tag) {
-      ::grpc::Service::RequestAsyncUnary(0, context, request, response, new_call_cq, notification_cq, tag);
-    }
-  };
-  template <class BaseClass>
-  class WithRawCallbackMethod_ProcessBatch : public BaseClass {
-   private:
-    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
-   public:
-    WithRawCallbackMethod_ProcessBatch() {
-      ::grpc::Service::MarkMethodRawCallback(0,
-          new ::grpc::internal::CallbackUnaryHandler< ::grpc::ByteBuffer, ::grpc::ByteBuffer>(
-            [this](
-                   ::grpc::CallbackServerContext* context, const ::grpc::ByteBuffer* request, ::grpc::ByteBuffer* response) { return this->ProcessBatch(context, request, response); }));
-    }
-    ~WithRawCallbackMethod_ProcessBatch() override {
-      BaseClassMustBeDerivedFromService(this);
-    }
-    // disable synchronous version of this method
-    ::grpc::Status ProcessBatch(::grpc::ServerContext* /*context*/, const ::ocr::BatchRequest* /*request*/, ::ocr::BatchResponse* /*response*/) override {
-      abort();
-      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
-    }
-    virtual ::grpc::ServerUnaryReactor* ProcessBatch(
-      ::grpc::CallbackServerContext* /*context*/, const ::grpc::ByteBuffer* /*request*/, ::grpc::ByteBuffer* /*response*/)  { return nullptr; }
-  };
-  template <class BaseClass>
-  class WithStreamedUnaryMethod_ProcessBatch : public BaseClass {
-   private:
-    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
-   public:
-    WithStreamedUnaryMethod_ProcessBatch() {
-      ::grpc::Service::MarkMethodStreamed(0,
-        new ::grpc::internal::StreamedUnaryHandler<
-          ::ocr::BatchRequest, ::ocr::BatchResponse>(
-            [this](::grpc::ServerContext* context,
-                   ::grpc::ServerUnaryStreamer<
-                     ::ocr::BatchRequest, ::ocr::BatchResponse>* streamer) {
-                       return this->StreamedProcessBatch(context,
-                         streamer);
-                  }));
-    }
-    ~WithStreamedUnaryMethod_ProcessBatch() override {
-      BaseClassMustBeDerivedFromService(this);
-    }
-    // disable regular version of this method
-    ::grpc::Status ProcessBatch(::grpc::ServerContext* /*context*/, const ::ocr::BatchRequest* /*request*/, ::ocr::BatchResponse* /*response*/) override {
-      abort();
-      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
-    }
-    // replace default version of method with streamed unary
-    virtual ::grpc::Status StreamedProcessBatch(::grpc::ServerContext* context, ::grpc::ServerUnaryStreamer< ::ocr::BatchRequest,::ocr::BatchResponse>* server_unary_streamer) = 0;
-  };
-  typedef WithStreamedUnaryMethod_ProcessBatch<Service > StreamedUnaryService;
-  typedef Service SplitStreamedService;
-  typedef WithStreamedUnaryMethod_ProcessBatch<Service > StreamedService;
-};
-
-}  // namespace ocr
-
-
-#include <grpcpp/ports_undef.inc>
-#endif  // GRPC_ocr_5fservice_2eproto__INCLUDED
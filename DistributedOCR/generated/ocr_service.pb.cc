@@ -1,1270 +0,0 @@
-// Generated by the protocol buffer compiler.  DO NOT EDIT!
-// NO CHECKED-IN PROTOBUF GENCODE
-// source: ocr_service.proto
-// Protobuf C++ Version: 5.29.5
-
-#include "ocr_service.pb.h"
-
-#include <algorithm>
-#include <type_traits>
-#include "google/protobuf/io/coded_stream.h"
-#include "google/protobuf/generated_message_tctable_impl.h"
-#include "google/protobuf/extension_set.h"
-#include "google/protobuf/generated_message_util.h"
-#include "google/protobuf/wire_format_lite.h"
-#include "google/protobuf/descriptor.h"
-#include "google/protobuf/generated_message_reflection.h"
-#include "google/protobuf/reflection_ops.h"
-#include "google/protobuf/wire_format.h"
-// @@protoc_insertion_point(includes)
-
-// Must be included last.
-#include "google/protobuf/port_def.inc"
-PROTOBUF_PRAGMA_INIT_SEG
-namespace _pb = ::google::protobuf;
-namespace _pbi = ::google::protobuf::internal;
-namespace _fl = ::google::protobuf::internal::field_layout;
-namespace ocr {
-
-inline constexpr ImageTask::Impl_::Impl_(
-    ::_pbi::ConstantInitialized) noexcept
-      : image_data_(
-            &::google::protobuf::internal::fixed_address_empty_string,
-            ::_pbi::ConstantInitialized()),
-        id_{0},
-        _cached_size_{0} {}
-
-template <typename>
-PROTOBUF_CONSTEXPR ImageTask::ImageTask(::_pbi::ConstantInitialized)
-#if defined(PROTOBUF_CUSTOM_VTABLE)
-    : ::google::protobuf::Message(_class_data_.base()),
-#else   // PROTOBUF_CUSTOM_VTABLE
-    : ::google::protobuf::Message(),
-#endif  // PROTOBUF_CUSTOM_VTABLE
-      _impl_(::_pbi::ConstantInitialized()) {
-}
-struct ImageTaskDefaultTypeInternal {
-  PROTOBUF_CONSTEXPR ImageTaskDefaultTypeInternal() : _instance(::_pbi::ConstantInitialized{}) {}
-  ~ImageTaskDefaultTypeInternal() {}
-  union {
-    ImageTask _instance;
-  };
-};
-
-PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT
-    PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 ImageTaskDefaultTypeInternal _ImageTask_default_instance_;
-
-inline constexpr BatchResult::Impl_::Impl_(
-    ::_pbi::ConstantInitialized) noexcept
-      : text_(
-            &::google::protobuf::internal::fixed_address_empty_string,
-            ::_pbi::ConstantInitialized()),
-        processing_time_ms_{::int64_t{0}},
-        id_{0},
-        _cached_size_{0} {}
-
-template <typename>
-PROTOBUF_CONSTEXPR BatchResult::BatchResult(::_pbi::ConstantInitialized)
-#if defined(PROTOBUF_CUSTOM_VTABLE)
-    : ::google::protobuf::Message(_class_data_.base()),
-#else   // PROTOBUF_CUSTOM_VTABLE
-    : ::google::protobuf::Message(),
-#endif  // PROTOBUF_CUSTOM_VTABLE
-      _impl_(::_pbi::ConstantInitialized()) {
-}
-struct BatchResultDefaultTypeInternal {
-  PROTOBUF_CONSTEXPR BatchResultDefaultTypeInternal() : _instance(::_pbi::ConstantInitialized{}) {}
-  ~BatchResultDefaultTypeInternal() {}
-  union {
-    BatchResult _instance;
-  };
-};
-
-PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT
-    PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 BatchResultDefaultTypeInternal _BatchResult_default_instance_;
-
-inline constexpr BatchResponse::Impl_::Impl_(
-    ::_pbi::ConstantInitialized) noexcept
-      : results_{},
-        _cached_size_{0} {}
-
-template <typename>
-PROTOBUF_CONSTEXPR BatchResponse::BatchResponse(::_pbi::ConstantInitialized)
-#if defined(PROTOBUF_CUSTOM_VTABLE)
-    : ::google::protobuf::Message(_class_data_.base()),
-#else   // PROTOBUF_CUSTOM_VTABLE
-    : ::google::protobuf::Message(),
-#endif  // PROTOBUF_CUSTOM_VTABLE
-      _impl_(::_pbi::ConstantInitialized()) {
-}
-struct BatchResponseDefaultTypeInternal {
-  PROTOBUF_CONSTEXPR BatchResponseDefaultTypeInternal() : _instance(::_pbi::ConstantInitialized{}) {}
-  ~BatchResponseDefaultTypeInternal() {}
-  union {
-    BatchResponse _instance;
-  };
-};
-
-PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT
-    PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 BatchResponseDefaultTypeInternal _BatchResponse_default_instance_;
-
-inline constexpr BatchRequest::Impl_::Impl_(
-    ::_pbi::ConstantInitialized) noexcept
-      : tasks_{},
-        _cached_size_{0} {}
-
-template <typename>
-PROTOBUF_CONSTEXPR BatchRequest::BatchRequest(::_pbi::ConstantInitialized)
-#if defined(PROTOBUF_CUSTOM_VTABLE)
-    : ::google::protobuf::Message(_class_data_.base()),
-#else   // PROTOBUF_CUSTOM_VTABLE
-    : ::google::protobuf::Message(),
-#endif  // PROTOBUF_CUSTOM_VTABLE
-      _impl_(::_pbi::ConstantInitialized()) {
-}
-struct BatchRequestDefaultTypeInternal {
-  PROTOBUF_CONSTEXPR BatchRequestDefaultTypeInternal() : _instance(::_pbi::ConstantInitialized{}) {}
-  ~BatchRequestDefaultTypeInternal() {}
-  union {
-    BatchRequest _instance;
-  };
-};
-
-PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT
-    PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 BatchRequestDefaultTypeInternal _BatchRequest_default_instance_;
-}  // namespace ocr
-static constexpr const ::_pb::EnumDescriptor**
-    file_level_enum_descriptors_ocr_5fservice_2eproto = nullptr;
-static constexpr const ::_pb::ServiceDescriptor**
-    file_level_service_descriptors_ocr_5fservice_2eproto = nullptr;
-const ::uint32_t
-    TableStruct_ocr_5fservice_2eproto::offsets[] ABSL_ATTRIBUTE_SECTION_VARIABLE(
-        protodesc_cold) = {
-        ~0u,  // no _has_bits_
-        PROTOBUF_FIELD_OFFSET(::ocr::ImageTask, _internal_metadata_),
-        ~0u,  // no _extensions_
-        ~0u,  // no _oneof_case_
-        ~0u,  // no _weak_field_map_
-        ~0u,  // no _inlined_string_donated_
-        ~0u,  // no _split_
-        ~0u,  // no sizeof(Split)
-        PROTOBUF_FIELD_OFFSET(::ocr::ImageTask, _impl_.id_),
-        PROTOBUF_FIELD_OFFSET(::ocr::ImageTask, _impl_.image_data_),
-        ~0u,  // no _has_bits_
-        PROTOBUF_FIELD_OFFSET(::ocr::BatchRequest, _internal_metadata_),
-        ~0u,  // no _extensions_
-        ~0u,  // no _oneof_case_
-        ~0u,  // no _weak_field_map_
-        ~0u,  // no _inlined_string_donated_
-        ~0u,  // no _split_
-        ~0u,  // no sizeof(Split)
-        PROTOBUF_FIELD_OFFSET(::ocr::BatchRequest, _impl_.tasks_),
-        ~0u,  // no _has_bits_
-        PROTOBUF_FIELD_OFFSET(::ocr::BatchResult, _internal_metadata_),
-        ~0u,  // no _extensions_
-        ~0u,  // no _oneof_case_
-        ~0u,  // no _weak_field_map_
-        ~0u,  // no _inlined_string_donated_
-        ~0u,  // no _split_
-        ~0u,  // no sizeof(Split)
-        PROTOBUF_FIELD_OFFSET(::ocr::BatchResult, _impl_.id_),
-        PROTOBUF_FIELD_OFFSET(::ocr::BatchResult, _impl_.text_),
-        PROTOBUF_FIELD_OFFSET(::ocr::BatchResult, _impl_.processing_time_ms_),
-        ~0u,  // no _has_bits_
-        PROTOBUF_FIELD_OFFSET(::ocr::BatchResponse, _internal_metadata_),
-        ~0u,  // no _extensions_
-        ~0u,  // no _oneof_case_
-        ~0u,  // no _weak_field_map_
-        ~0u,  // no _inlined_string_donated_
-        ~0u,  // no _split_
-        ~0u,  // no sizeof(Split)
-        PROTOBUF_FIELD_OFFSET(::ocr::BatchResponse, _impl_.results_),
-};
-
-static const ::_pbi::MigrationSchema
-    schemas[] ABSL_ATTRIBUTE_SECTION_VARIABLE(protodesc_cold) = {
-        {0, -1, -1, sizeof(::ocr::ImageTask)},
-        {10, -1, -1, sizeof(::ocr::BatchRequest)},
-        {19, -1, -1, sizeof(::ocr::BatchResult)},
-        {30, -1, -1, sizeof(::ocr::BatchResponse)},
-};
-static const ::_pb::Message* const file_default_instances[] = {
-    &::ocr::_ImageTask_default_instance_._instance,
-    &::ocr::_BatchRequest_default_instance_._instance,
-    &::ocr::_BatchResult_default_instance_._instance,
-    &::ocr::_BatchResponse_default_instance_._instance,
-};
-const char descriptor_table_protodef_ocr_5fservice_2eproto[] ABSL_ATTRIBUTE_SECTION_VARIABLE(
-    protodesc_cold) = {
-    "\n\021ocr_service.proto\022\003ocr\"+\n\tImageTask\022\n\n"
-    "\002id\030\001 \001(\005\022\022\n\nimage_data\030\002 \001(\014\"-\n\014BatchRe"
-    "quest\022\035\n\005tasks\030\001 \003(\0132\016.ocr.ImageTask\"C\n\013"
-    "BatchResult\022\n\n\002id\030\001 \001(\005\022\014\n\004text\030\002 \001(\t\022\032\n"
-    "\022processing_time_ms\030\003 \001(\003\"2\n\rBatchRespon"
-    "se\022!\n\007results\030\001 \003(\0132\020.ocr.BatchResult2C\n"
-    "\nOCRService\0225\n\014ProcessBatch\022\021.ocr.BatchR"
-    "equest\032\022.ocr.BatchResponseb\006proto3"
-};
-static ::absl::once_flag descriptor_table_ocr_5fservice_2eproto_once;
-PROTOBUF_CONSTINIT const ::_pbi::DescriptorTable descriptor_table_ocr_5fservice_2eproto = {
-    false,
-    false,
-    314,
-    descriptor_table_protodef_ocr_5fservice_2eproto,
-    "ocr_service.proto",
-    &descriptor_table_ocr_5fservice_2eproto_once,
-    nullptr,
-    0,
-    4,
-    schemas,
-    file_default_instances,
-    TableStruct_ocr_5fservice_2eproto::offsets,
-    file_level_enum_descriptors_ocr_5fservice_2eproto,
-    file_level_service_descriptors_ocr_5fservice_2eproto,
-};
-namespace ocr {
-// ===================================================================
-
-class ImageTask::_Internal {
- public:
-};
-
-ImageTask::ImageTask(::google::protobuf::Arena* arena)
-#if defined(PROTOBUF_CUSTOM_VTABLE)
-    : ::google::protobuf::Message(arena, _class_data_.base()) {
-#else   // PROTOBUF_CUSTOM_VTABLE
-    : ::google::protobuf::Message(arena) {
-#endif  // PROTOBUF_CUSTOM_VTABLE
-  SharedCtor(arena);
-  // @@protoc_insertion_point(arena_constructor:ocr.ImageTask)
-}
-inline PROTOBUF_NDEBUG_INLINE ImageTask::Impl_::Impl_(
-    ::google::protobuf::internal::InternalVisibility visibility, ::google::protobuf::Arena* arena,
-    const Impl_& from, const ::ocr::ImageTask& from_msg)
-      : image_data_(arena, from.image_data_),
-        _cached_size_{0} {}
-
-ImageTask::ImageTask(
-    ::google::protobuf::Arena* arena,
-    const ImageTask& from)
-#if defined(PROTOBUF_CUSTOM_VTABLE)
-    : ::google::protobuf::Message(arena, _class_data_.base()) {
-#else   // PROTOBUF_CUSTOM_VTABLE
-    : ::google::protobuf::Message(arena) {
-#endif  // PROTOBUF_CUSTOM_VTABLE
-  ImageTask* const _this = this;
-  (void)_this;
-  _internal_metadata_.MergeFrom<::google::protobuf::UnknownFieldSet>(
-      from._internal_metadata_);
-  new (&_impl_) Impl_(internal_visibility(), arena, from._impl_, from);
-  _impl_.id_ = from._impl_.id_;
-
-  // @@protoc_insertion_point(copy_constructor:ocr.ImageTask)
-}
-inline PROTOBUF_NDEBUG_INLINE ImageTask::Impl_::Impl_(
-    ::google::protobuf::internal::InternalVisibility visibility,
-    ::google::protobuf::Arena* arena)
-      : image_data_(arena),
-        _cached_size_{0} {}
-
-inline void ImageTask::SharedCtor(::_pb::Arena* arena) {
-  new (&_impl_) Impl_(internal_visibility(), arena);
-  _impl_.id_ = {};
-}
-ImageTask::~ImageTask() {
-  // @@protoc_insertion_point(destructor:ocr.ImageTask)
-  SharedDtor(*this);
-}
-inline void ImageTask::SharedDtor(MessageLite& self) {
-  ImageTask& this_ = static_cast<ImageTask&>(self);
-  this_._internal_metadata_.Delete<::google::protobuf::UnknownFieldSet>();
-  ABSL_DCHECK(this_.GetArena() == nullptr);
-  this_._impl_.image_data_.Destroy();
-  this_._impl_.~Impl_();
-}
-
-inline void* ImageTask::PlacementNew_(const void*, void* mem,
-                                        ::google::protobuf::Arena* arena) {
-  return ::new (mem) ImageTask(arena);
-}
-constexpr auto ImageTask::InternalNewImpl_() {
-  return ::google::protobuf::internal::MessageCreator::CopyInit(sizeof(ImageTask),
-                                            alignof(ImageTask));
-}
-PROTOBUF_CONSTINIT
-PROTOBUF_ATTRIBUTE_INIT_PRIORITY1
-const ::google::protobuf::internal::ClassDataFull ImageTask::_class_data_ = {
-    ::google::protobuf::internal::ClassData{
-        &_ImageTask_default_instance_._instance,
-        &_table_.header,
-        nullptr,  // OnDemandRegisterArenaDtor
-        nullptr,  // IsInitialized
-        &ImageTask::MergeImpl,
-        ::google::protobuf::Message::GetNewImpl<ImageTask>(),
-#if defined(PROTOBUF_CUSTOM_VTABLE)
-        &ImageTask::SharedDtor,
-        ::google::protobuf::Message::GetClearImpl<ImageTask>(), &ImageTask::ByteSizeLong,
-            &ImageTask::_InternalSerialize,
-#endif  // PROTOBUF_CUSTOM_VTABLE
-        PROTOBUF_FIELD_OFFSET(ImageTask, _impl_._cached_size_),
-        false,
-    },
-    &ImageTask::kDescriptorMethods,
-    &descriptor_table_ocr_5fservice_2eproto,
-    nullptr,  // tracker
-};
-const ::google::protobuf::internal::ClassData* ImageTask::GetClassData() const {
-  ::google::protobuf::internal::PrefetchToLocalCache(&_class_data_);
-  ::google::protobuf::internal::PrefetchToLocalCache(_class_data_.tc_table);
-  return _class_data_.base();
-}
-PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1
-const ::_pbi::TcParseTable<1, 2, 0, 0, 2> ImageTask::_table_ = {
-  {
-    0,  // no _has_bits_
-    0, // no _extensions_
-    2, 8,  // max_field_number, fast_idx_mask
-    offsetof(decltype(_table_), field_lookup_table),
-    4294967292,  // skipmap
-    offsetof(decltype(_table_), field_entries),
-    2,  // num_field_entries
-    0,  // num_aux_entries
-    offsetof(decltype(_table_), field_names),  // no aux_entries
-    _class_data_.base(),
-    nullptr,  // post_loop_handler
-    ::_pbi::TcParser::GenericFallback,  // fallback
-    #ifdef PROTOBUF_PREFETCH_PARSE_TABLE
-    ::_pbi::TcParser::GetTable<::ocr::ImageTask>(),  // to_prefetch
-    #endif  // PROTOBUF_PREFETCH_PARSE_TABLE
-  }, {{
-    // bytes image_data = 2;
-    {::_pbi::TcParser::FastBS1,
-     {18, 63, 0, PROTOBUF_FIELD_OFFSET(ImageTask, _impl_.image_data_)}},
-    // int32 id = 1;
-    {::_pbi::TcParser::SingularVarintNoZag1<::uint32_t, offsetof(ImageTask, _impl_.id_), 63>(),
-     {8, 63, 0, PROTOBUF_FIELD_OFFSET(ImageTask, _impl_.id_)}},
-  }}, {{
-    65535, 65535
-  }}, {{
-    // int32 id = 1;
-    {PROTOBUF_FIELD_OFFSET(ImageTask, _impl_.id_), 0, 0,
-    (0 | ::_fl::kFcSingular | ::_fl::kInt32)},
-    // bytes image_data = 2;
-    {PROTOBUF_FIELD_OFFSET(ImageTask, _impl_.image_data_), 0, 0,
-    (0 | ::_fl::kFcSingular | ::_fl::kBytes | ::_fl::kRepAString)},
-  }},
-  // no aux_entries
-  {{
-  }},
-};
-
-PROTOBUF_NOINLINE void ImageTask::Clear() {
-// @@protoc_insertion_point(message_clear_start:ocr.ImageTask)
-  ::google::protobuf::internal::TSanWrite(&_impl_);
-  ::uint32_t cached_has_bits = 0;
-  // Prevent compiler warnings about cached_has_bits being unused
-  (void) cached_has_bits;
-
-  _impl_.image_data_.ClearToEmpty();
-  _impl_.id_ = 0;
-  _internal_metadata_.Clear<::google::protobuf::UnknownFieldSet>();
-}
-
-#if defined(PROTOBUF_CUSTOM_VTABLE)
-        ::uint8_t* ImageTask::_InternalSerialize(
-            const MessageLite& base, ::uint8_t* target,
-            ::google::protobuf::io::EpsCopyOutputStream* stream) {
-          const ImageTask& this_ = static_cast<const ImageTask&>(base);
-#else   // PROTOBUF_CUSTOM_VTABLE
-        ::uint8_t* ImageTask::_InternalSerialize(
-            ::uint8_t* target,
-            ::google::protobuf::io::EpsCopyOutputStream* stream) const {
-          const ImageTask& this_ = *this;
-#endif  // PROTOBUF_CUSTOM_VTABLE
-          // @@protoc_insertion_point(serialize_to_array_start:ocr.ImageTask)
-          ::uint32_t cached_has_bits = 0;
-          (void)cached_has_bits;
-
-          // int32 id = 1;
-          if (this_._internal_id() != 0) {
-            target = ::google::protobuf::internal::WireFormatLite::
-                WriteInt32ToArrayWithField<1>(
-                    stream, this_._internal_id(), target);
-          }
-
-          // bytes image_data = 2;
-          if (!this_._internal_image_data().empty()) {
-            const std::string& _s = this_._internal_image_data();
-            target = stream->WriteBytesMaybeAliased(2, _s, target);
-          }
-
-          if (PROTOBUF_PREDICT_FALSE(this_._internal_metadata_.have_unknown_fields())) {
-            target =
-                ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
-                    this_._internal_metadata_.unknown_fields<::google::protobuf::UnknownFieldSet>(::google::protobuf::UnknownFieldSet::default_instance), target, stream);
-          }
-          // @@protoc_insertion_point(serialize_to_array_end:ocr.ImageTask)
-          return target;
-        }
-
-#if defined(PROTOBUF_CUSTOM_VTABLE)
-        ::size_t ImageTask::ByteSizeLong(const MessageLite& base) {
-          const ImageTask& this_ = static_cast<const ImageTask&>(base);
-#else   // PROTOBUF_CUSTOM_VTABLE
-        ::size_t ImageTask::ByteSizeLong() const {
-          const ImageTask& this_ = *this;
-#endif  // PROTOBUF_CUSTOM_VTABLE
-          // @@protoc_insertion_point(message_byte_size_start:ocr.ImageTask)
-          ::size_t total_size = 0;
-
-          ::uint32_t cached_has_bits = 0;
-          // Prevent compiler warnings about cached_has_bits being unused
-          (void)cached_has_bits;
-
-          ::_pbi::Prefetch5LinesFrom7Lines(&this_);
-           {
-            // bytes image_data = 2;
-            if (!this_._internal_image_data().empty()) {
-              total_size += 1 + ::google::protobuf::internal::WireFormatLite::BytesSize(
-                                              this_._internal_image_data());
-            }
-            // int32 id = 1;
-            if (this_._internal_id() != 0) {
-              total_size += ::_pbi::WireFormatLite::Int32SizePlusOne(
-                  this_._internal_id());
-            }
-          }
-          return this_.MaybeComputeUnknownFieldsSize(total_size,
-                                                     &this_._impl_._cached_size_);
-        }
-
-void ImageTask::MergeImpl(::google::protobuf::MessageLite& to_msg, const ::google::protobuf::MessageLite& from_msg) {
-  auto* const _this = static_cast<ImageTask*>(&to_msg);
-  auto& from = static_cast<const ImageTask&>(from_msg);
-  // @@protoc_insertion_point(class_specific_merge_from_start:ocr.ImageTask)
-  ABSL_DCHECK_NE(&from, _this);
-  ::uint32_t cached_has_bits = 0;
-  (void) cached_has_bits;
-
-  if (!from._internal_image_data().empty()) {
-    _this->_internal_set_image_data(from._internal_image_data());
-  }
-  if (from._internal_id() != 0) {
-    _this->_impl_.id_ = from._impl_.id_;
-  }
-  _this->_internal_metadata_.MergeFrom<::google::protobuf::UnknownFieldSet>(from._internal_metadata_);
-}
-
-void ImageTask::CopyFrom(const ImageTask& from) {
-// @@protoc_insertion_point(class_specific_copy_from_start:ocr.ImageTask)
-  if (&from == this) return;
-  Clear();
-  MergeFrom(from);
-}
-
-
-void ImageTask::InternalSwap(ImageTask* PROTOBUF_RESTRICT other) {
-  using std::swap;
-  auto* arena = GetArena();
-  ABSL_DCHECK_EQ(arena, other->GetArena());
-  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
-  ::_pbi::ArenaStringPtr::InternalSwap(&_impl_.image_data_, &other->_impl_.image_data_, arena);
-        swap(_impl_.id_, other->_impl_.id_);
-}
-
-::google::protobuf::Metadata ImageTask::GetMetadata() const {
-  return ::google::protobuf::Message::GetMetadataImpl(GetClassData()->full());
-}
-// ===================================================================
-
-class BatchRequest::_Internal {
- public:
-};
-
-BatchRequest::BatchRequest(::google::protobuf::Arena* arena)
-#if defined(PROTOBUF_CUSTOM_VTABLE)
-    : ::google::protobuf::Message(arena, _class_data_.base()) {
-#else   // PROTOBUF_CUSTOM_VTABLE
-    : ::google::protobuf::Message(arena) {
-#endif  // PROTOBUF_CUSTOM_VTABLE
-  SharedCtor(arena);
-  // @@protoc_insertion_point(arena_constructor:ocr.BatchRequest)
-}
-inline PROTOBUF_NDEBUG_INLINE BatchRequest::Impl_::Impl_(
-    ::google::protobuf::internal::InternalVisibility visibility, ::google::protobuf::Arena* arena,
-    const Impl_& from, const ::ocr::BatchRequest& from_msg)
-      : tasks_{visibility, arena, from.tasks_},
-        _cached_size_{0} {}
-
-BatchRequest::BatchRequest(
-    ::google::protobuf::Arena* arena,
-    const BatchRequest& from)
-#if defined(PROTOBUF_CUSTOM_VTABLE)
-    : ::google::protobuf::Message(arena, _class_data_.base()) {
-#else   // PROTOBUF_CUSTOM_VTABLE
-    : ::google::protobuf::Message(arena) {
-#endif  // PROTOBUF_CUSTOM_VTABLE
-  BatchRequest* const _this = this;
-  (void)_this;
-  _internal_metadata_.MergeFrom<::google::protobuf::UnknownFieldSet>(
-      from._internal_metadata_);
-  new (&_impl_) Impl_(internal_visibility(), arena, from._impl_, from);
-
-  // @@protoc_insertion_point(copy_constructor:ocr.BatchRequest)
-}
-inline PROTOBUF_NDEBUG_INLINE BatchRequest::Impl_::Impl_(
-    ::google::protobuf::internal::InternalVisibility visibility,
-    ::google::protobuf::Arena* arena)
-      : tasks_{visibility, arena},
-        _cached_size_{0} {}
-
-inline void BatchRequest::SharedCtor(::_pb::Arena* arena) {
-  new (&_impl_) Impl_(internal_visibility(), arena);
-}
-BatchRequest::~BatchRequest() {
-  // @@protoc_insertion_point(destructor:ocr.BatchRequest)
-  SharedDtor(*this);
-}
-inline void BatchRequest::SharedDtor(MessageLite& self) {
-  BatchRequest& this_ = static_cast<BatchRequest&>(self);
-  this_._internal_metadata_.Delete<::google::protobuf::UnknownFieldSet>();
-  ABSL_DCHECK(this_.GetArena() == nullptr);
-  this_._impl_.~Impl_();
-}
-
-inline void* BatchRequest::PlacementNew_(const void*, void* mem,
-                                        ::google::protobuf::Arena* arena) {
-  return ::new (mem) BatchRequest(arena);
-}
-constexpr auto BatchRequest::InternalNewImpl_() {
-  constexpr auto arena_bits = ::google::protobuf::internal::EncodePlacementArenaOffsets({
-      PROTOBUF_FIELD_OFFSET(BatchRequest, _impl_.tasks_) +
-          decltype(BatchRequest::_impl_.tasks_)::
-              InternalGetArenaOffset(
-                  ::google::protobuf::Message::internal_visibility()),
-  });
-  if (arena_bits.has_value()) {
-    return ::google::protobuf::internal::MessageCreator::ZeroInit(
-        sizeof(BatchRequest), alignof(BatchRequest), *arena_bits);
-  } else {
-    return ::google::protobuf::internal::MessageCreator(&BatchRequest::PlacementNew_,
-                                 sizeof(BatchRequest),
-                                 alignof(BatchRequest));
-  }
-}
-PROTOBUF_CONSTINIT
-PROTOBUF_ATTRIBUTE_INIT_PRIORITY1
-const ::google::protobuf::internal::ClassDataFull BatchRequest::_class_data_ = {
-    ::google::protobuf::internal::ClassData{
-        &_BatchRequest_default_instance_._instance,
-        &_table_.header,
-        nullptr,  // OnDemandRegisterArenaDtor
-        nullptr,  // IsInitialized
-        &BatchRequest::MergeImpl,
-        ::google::protobuf::Message::GetNewImpl<BatchRequest>(),
-#if defined(PROTOBUF_CUSTOM_VTABLE)
-        &BatchRequest::SharedDtor,
-        ::google::protobuf::Message::GetClearImpl<BatchRequest>(), &BatchRequest::ByteSizeLong,
-            &BatchRequest::_InternalSerialize,
-#endif  // PROTOBUF_CUSTOM_VTABLE
-        PROTOBUF_FIELD_OFFSET(BatchRequest, _impl_._cached_size_),
-        false,
-    },
-    &BatchRequest::kDescriptorMethods,
-    &descriptor_table_ocr_5fservice_2eproto,
-    nullptr,  // tracker
-};
-const ::google::protobuf::internal::ClassData* BatchRequest::GetClassData() const {
-  ::google::protobuf::internal::PrefetchToLocalCache(&_class_data_);
-  ::google::protobuf::internal::PrefetchToLocalCache(_class_data_.tc_table);
-  return _class_data_.base();
-}
-PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1
-const ::_pbi::TcParseTable<0, 1, 1, 0, 2> BatchRequest::_table_ = {
-  {
-    0,  // no _has_bits_
-    0, // no _extensions_
-    1, 0,  // max_field_number, fast_idx_mask
-    offsetof(decltype(_table_), field_lookup_table),
-    4294967294,  // skipmap
-    offsetof(decltype(_table_), field_entries),
-    1,  // num_field_entries
-    1,  // num_aux_entries
-    offsetof(decltype(_table_), aux_entries),
-    _class_data_.base(),
-    nullptr,  // post_loop_handler
-    ::_pbi::TcParser::GenericFallback,  // fallback
-    #ifdef PROTOBUF_PREFETCH_PARSE_TABLE
-    ::_pbi::TcParser::GetTable<::ocr::BatchRequest>(),  // to_prefetch
-    #endif  // PROTOBUF_PREFETCH_PARSE_TABLE
-  }, {{
-    // repeated .ocr.ImageTask tasks = 1;
-    {::_pbi::TcParser::FastMtR1,
-     {10, 63, 0, PROTOBUF_FIELD_OFFSET(BatchRequest, _impl_.tasks_)}},
-  }}, {{
-    65535, 65535
-  }}, {{
-    // repeated .ocr.ImageTask tasks = 1;
-    {PROTOBUF_FIELD_OFFSET(BatchRequest, _impl_.tasks_), 0, 0,
-    (0 | ::_fl::kFcRepeated | ::_fl::kMessage | ::_fl::kTvTable)},
-  }}, {{
-    {::_pbi::TcParser::GetTable<::ocr::ImageTask>()},
-  }}, {{
-  }},
-};
-
-PROTOBUF_NOINLINE void BatchRequest::Clear() {
-// @@protoc_insertion_point(message_clear_start:ocr.BatchRequest)
-  ::google::protobuf::internal::TSanWrite(&_impl_);
-  ::uint32_t cached_has_bits = 0;
-  // Prevent compiler warnings about cached_has_bits being unused
-  (void) cached_has_bits;
-
-  _impl_.tasks_.Clear();
-  _internal_metadata_.Clear<::google::protobuf::UnknownFieldSet>();
-}
-
-#if defined(PROTOBUF_CUSTOM_VTABLE)
-        ::uint8_t* BatchRequest::_InternalSerialize(
-            const MessageLite& base, ::uint8_t* target,
-            ::google::protobuf::io::EpsCopyOutputStream* stream) {
-          const BatchRequest& this_ = static_cast<const BatchRequest&>(base);
-#else   // PROTOBUF_CUSTOM_VTABLE
-        ::uint8_t* BatchRequest::_InternalSerialize(
-            ::uint8_t* target,
-            ::google::protobuf::io::EpsCopyOutputStream* stream) const {
-          const BatchRequest& this_ = *this;
-#endif  // PROTOBUF_CUSTOM_VTABLE
-          // @@protoc_insertion_point(serialize_to_array_start:ocr.BatchRequest)
-          ::uint32_t cached_has_bits = 0;
-          (void)cached_has_bits;
-
-          // repeated .ocr.ImageTask tasks = 1;
-          for (unsigned i = 0, n = static_cast<unsigned>(
-                                   this_._internal_tasks_size());
-               i < n; i++) {
-            const auto& repfield = this_._internal_tasks().Get(i);
-            target =
-                ::google::protobuf::internal::WireFormatLite::InternalWriteMessage(
-                    1, repfield, repfield.GetCachedSize(),
-                    target, stream);
-          }
-
-          if (PROTOBUF_PREDICT_FALSE(this_._internal_metadata_.have_unknown_fields())) {
-            target =
-                ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
-                    this_._internal_metadata_.unknown_fields<::google::protobuf::UnknownFieldSet>(::google::protobuf::UnknownFieldSet::default_instance), target, stream);
-          }
-          // @@protoc_insertion_point(serialize_to_array_end:ocr.BatchRequest)
-          return target;
-        }
-
-#if defined(PROTOBUF_CUSTOM_VTABLE)
-        ::size_t BatchRequest::ByteSizeLong(const MessageLite& base) {
-          const BatchRequest& this_ = static_cast<const BatchRequest&>(base);
-#else   // PROTOBUF_CUSTOM_VTABLE
-        ::size_t BatchRequest::ByteSizeLong() const {
-          const BatchRequest& this_ = *this;
-#endif  // PROTOBUF_CUSTOM_VTABLE
-          // @@protoc_insertion_point(message_byte_size_start:ocr.BatchRequest)
-          ::size_t total_size = 0;
-
-          ::uint32_t cached_has_bits = 0;
-          // Prevent compiler warnings about cached_has_bits being unused
-          (void)cached_has_bits;
-
-          ::_pbi::Prefetch5LinesFrom7Lines(&this_);
-           {
-            // repeated .ocr.ImageTask tasks = 1;
-            {
-              total_size += 1UL * this_._internal_tasks_size();
-              for (const auto& msg : this_._internal_tasks()) {
-                total_size += ::google::protobuf::internal::WireFormatLite::MessageSize(msg);
-              }
-            }
-          }
-          return this_.MaybeComputeUnknownFieldsSize(total_size,
-                                                     &this_._impl_._cached_size_);
-        }
-
-void BatchRequest::MergeImpl(::google::protobuf::MessageLite& to_msg, const ::google::protobuf::MessageLite& from_msg) {
-  auto* const _this = static_cast<BatchRequest*>(&to_msg);
-  auto& from = static_cast<const BatchRequest&>(from_msg);
-  // @@protoc_insertion_point(class_specific_merge_from_start:ocr.BatchRequest)
-  ABSL_DCHECK_NE(&from, _this);
-  ::uint32_t cached_has_bits = 0;
-  (void) cached_has_bits;
-
-  _this->_internal_mutable_tasks()->MergeFrom(
-      from._internal_tasks());
-  _this->_internal_metadata_.MergeFrom<::google::protobuf::UnknownFieldSet>(from._internal_metadata_);
-}
-
-void BatchRequest::CopyFrom(const BatchRequest& from) {
-// @@protoc_insertion_point(class_specific_copy_from_start:ocr.BatchRequest)
-  if (&from == this) return;
-  Clear();
-  MergeFrom(from);
-}
-
-
-void BatchRequest::InternalSwap(BatchRequest* PROTOBUF_RESTRICT other) {
-  using std::swap;
-  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
-  _impl_.tasks_.InternalSwap(&other->_impl_.tasks_);
-}
-
-::google::protobuf::Metadata BatchRequest::GetMetadata() const {
-  return ::google::protobuf::Message::GetMetadataImpl(GetClassData()->full());
-}
-// ===================================================================
-
-class BatchResult::_Internal {
- public:
-};
-
-BatchResult::BatchResult(::google::protobuf::Arena* arena)
-#if defined(PROTOBUF_CUSTOM_VTABLE)
-    : ::google::protobuf::Message(arena, _class_data_.base()) {
-#else   // PROTOBUF_CUSTOM_VTABLE
-    : ::google::protobuf::Message(arena) {
-#endif  // PROTOBUF_CUSTOM_VTABLE
-  SharedCtor(arena);
-  // @@protoc_insertion_point(arena_constructor:ocr.BatchResult)
-}
-inline PROTOBUF_NDEBUG_INLINE BatchResult::Impl_::Impl_(
-    ::google::protobuf::internal::InternalVisibility visibility, ::google::protobuf::Arena* arena,
-    const Impl_& from, const ::ocr::BatchResult& from_msg)
-      : text_(arena, from.text_),
-        _cached_size_{0} {}
-
-BatchResult::BatchResult(
-    ::google::protobuf::Arena* arena,
-    const BatchResult& from)
-#if defined(PROTOBUF_CUSTOM_VTABLE)
-    : ::google::protobuf::Message(arena, _class_data_.base()) {
-#else   // PROTOBUF_CUSTOM_VTABLE
-    : ::google::protobuf::Message(arena) {
-#endif  // PROTOBUF_CUSTOM_VTABLE
-  BatchResult* const _this = this;
-  (void)_this;
-  _internal_metadata_.MergeFrom<::google::protobuf::UnknownFieldSet>(
-      from._internal_metadata_);
-  new (&_impl_) Impl_(internal_visibility(), arena, from._impl_, from);
-  ::memcpy(reinterpret_cast<char *>(&_impl_) +
-               offsetof(Impl_, processing_time_ms_),
-           reinterpret_cast<const char *>(&from._impl_) +
-               offsetof(Impl_, processing_time_ms_),
-           offsetof(Impl_, id_) -
-               offsetof(Impl_, processing_time_ms_) +
-               sizeof(Impl_::id_));
-
-  // @@protoc_insertion_point(copy_constructor:ocr.BatchResult)
-}
-inline PROTOBUF_NDEBUG_INLINE BatchResult::Impl_::Impl_(
-    ::google::protobuf::internal::InternalVisibility visibility,
-    ::google::protobuf::Arena* arena)
-      : text_(arena),
-        _cached_size_{0} {}
-
-inline void BatchResult::SharedCtor(::_pb::Arena* arena) {
-  new (&_impl_) Impl_(internal_visibility(), arena);
-  ::memset(reinterpret_cast<char *>(&_impl_) +
-               offsetof(Impl_, processing_time_ms_),
-           0,
-           offsetof(Impl_, id_) -
-               offsetof(Impl_, processing_time_ms_) +
-               sizeof(Impl_::id_));
-}
-BatchResult::~BatchResult() {
-  // @@protoc_insertion_point(destructor:ocr.BatchResult)
-  SharedDtor(*this);
-}
-inline void BatchResult::SharedDtor(MessageLite& self) {
-  BatchResult& this_ = static_cast<BatchResult&>(self);
-  this_._internal_metadata_.Delete<::google::protobuf::UnknownFieldSet>();
-  ABSL_DCHECK(this_.GetArena() == nullptr);
-  this_._impl_.text_.Destroy();
-  this_._impl_.~Impl_();
-}
-
-inline void* BatchResult::PlacementNew_(const void*, void* mem,
-                                        ::google::protobuf::Arena* arena) {
-  return ::new (mem) BatchResult(arena);
-}
-constexpr auto BatchResult::InternalNewImpl_() {
-  return ::google::protobuf::internal::MessageCreator::CopyInit(sizeof(BatchResult),
-                                            alignof(BatchResult));
-}
-PROTOBUF_CONSTINIT
-PROTOBUF_ATTRIBUTE_INIT_PRIORITY1
-const ::google::protobuf::internal::ClassDataFull BatchResult::_class_data_ = {
-    ::google::protobuf::internal::ClassData{
-        &_BatchResult_default_instance_._instance,
-        &_table_.header,
-        nullptr,  // OnDemandRegisterArenaDtor
-        nullptr,  // IsInitialized
-        &BatchResult::MergeImpl,
-        ::google::protobuf::Message::GetNewImpl<BatchResult>(),
-#if defined(PROTOBUF_CUSTOM_VTABLE)
-        &BatchResult::SharedDtor,
-        ::google::protobuf::Message::GetClearImpl<BatchResult>(), &BatchResult::ByteSizeLong,
-            &BatchResult::_InternalSerialize,
-#endif  // PROTOBUF_CUSTOM_VTABLE
-        PROTOBUF_FIELD_OFFSET(BatchResult, _impl_._cached_size_),
-        false,
-    },
-    &BatchResult::kDescriptorMethods,
-    &descriptor_table_ocr_5fservice_2eproto,
-    nullptr,  // tracker
-};
-const ::google::protobuf::internal::ClassData* BatchResult::GetClassData() const {
-  ::google::protobuf::internal::PrefetchToLocalCache(&_class_data_);
-  ::google::protobuf::internal::PrefetchToLocalCache(_class_data_.tc_table);
-  return _class_data_.base();
-}
-PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1
-const ::_pbi::TcParseTable<2, 3, 0, 28, 2> BatchResult::_table_ = {
-  {
-    0,  // no _has_bits_
-    0, // no _extensions_
-    3, 24,  // max_field_number, fast_idx_mask
-    offsetof(decltype(_table_), field_lookup_table),
-    4294967288,  // skipmap
-    offsetof(decltype(_table_), field_entries),
-    3,  // num_field_entries
-    0,  // num_aux_entries
-    offsetof(decltype(_table_), field_names),  // no aux_entries
-    _class_data_.base(),
-    nullptr,  // post_loop_handler
-    ::_pbi::TcParser::GenericFallback,  // fallback
-    #ifdef PROTOBUF_PREFETCH_PARSE_TABLE
-    ::_pbi::TcParser::GetTable<::ocr::BatchResult>(),  // to_prefetch
-    #endif  // PROTOBUF_PREFETCH_PARSE_TABLE
-  }, {{
-    {::_pbi::TcParser::MiniParse, {}},
-    // int32 id = 1;
-    {::_pbi::TcParser::SingularVarintNoZag1<::uint32_t, offsetof(BatchResult, _impl_.id_), 63>(),
-     {8, 63, 0, PROTOBUF_FIELD_OFFSET(BatchResult, _impl_.id_)}},
-    // string text = 2;
-    {::_pbi::TcParser::FastUS1,
-     {18, 63, 0, PROTOBUF_FIELD_OFFSET(BatchResult, _impl_.text_)}},
-    // int64 processing_time_ms = 3;
-    {::_pbi::TcParser::SingularVarintNoZag1<::uint64_t, offsetof(BatchResult, _impl_.processing_time_ms_), 63>(),
-     {24, 63, 0, PROTOBUF_FIELD_OFFSET(BatchResult, _impl_.processing_time_ms_)}},
-  }}, {{
-    65535, 65535
-  }}, {{
-    // int32 id = 1;
-    {PROTOBUF_FIELD_OFFSET(BatchResult, _impl_.id_), 0, 0,
-    (0 | ::_fl::kFcSingular | ::_fl::kInt32)},
-    // string text = 2;
-    {PROTOBUF_FIELD_OFFSET(BatchResult, _impl_.text_), 0, 0,
-    (0 | ::_fl::kFcSingular | ::_fl::kUtf8String | ::_fl::kRepAString)},
-    // int64 processing_time_ms = 3;
-    {PROTOBUF_FIELD_OFFSET(BatchResult, _impl_.processing_time_ms_), 0, 0,
-    (0 | ::_fl::kFcSingular | ::_fl::kInt64)},
-  }},
-  // no aux_entries
-  {{
-    "\17\0\4\0\0\0\0\0"
-    "ocr.BatchResult"
-    "text"
-  }},
-};
-
-PROTOBUF_NOINLINE void BatchResult::Clear() {
-// @@protoc_insertion_point(message_clear_start:ocr.BatchResult)
-  ::google::protobuf::internal::TSanWrite(&_impl_);
-  ::uint32_t cached_has_bits = 0;
-  // Prevent compiler warnings about cached_has_bits being unused
-  (void) cached_has_bits;
-
-  _impl_.text_.ClearToEmpty();
-  ::memset(&_impl_.processing_time_ms_, 0, static_cast<::size_t>(
-      reinterpret_cast<char*>(&_impl_.id_) -
-      reinterpret_cast<char*>(&_impl_.processing_time_ms_)) + sizeof(_impl_.id_));
-  _internal_metadata_.Clear<::google::protobuf::UnknownFieldSet>();
-}
-
-#if defined(PROTOBUF_CUSTOM_VTABLE)
-        ::uint8_t* BatchResult::_InternalSerialize(
-            const MessageLite& base, ::uint8_t* target,
-            ::google::protobuf::io::EpsCopyOutputStream* stream) {
-          const BatchResult& this_ = static_cast<const BatchResult&>(base);
-#else   // PROTOBUF_CUSTOM_VTABLE
-        ::uint8_t* BatchResult::_InternalSerialize(
-            ::uint8_t* target,
-            ::google::protobuf::io::EpsCopyOutputStream* stream) const {
-          const BatchResult& this_ = *this;
-#endif  // PROTOBUF_CUSTOM_VTABLE
-          // @@protoc_insertion_point(serialize_to_array_start:ocr.BatchResult)
-          ::uint32_t cached_has_bits = 0;
-          (void)cached_has_bits;
-
-          // int32 id = 1;
-          if (this_._internal_id() != 0) {
-            target = ::google::protobuf::internal::WireFormatLite::
-                WriteInt32ToArrayWithField<1>(
-                    stream, this_._internal_id(), target);
-          }
-
-          // string text = 2;
-          if (!this_._internal_text().empty()) {
-            const std::string& _s = this_._internal_text();
-            ::google::protobuf::internal::WireFormatLite::VerifyUtf8String(
-                _s.data(), static_cast<int>(_s.length()), ::google::protobuf::internal::WireFormatLite::SERIALIZE, "ocr.BatchResult.text");
-            target = stream->WriteStringMaybeAliased(2, _s, target);
-          }
-
-          // int64 processing_time_ms = 3;
-          if (this_._internal_processing_time_ms() != 0) {
-            target = ::google::protobuf::internal::WireFormatLite::
-                WriteInt64ToArrayWithField<3>(
-                    stream, this_._internal_processing_time_ms(), target);
-          }
-
-          if (PROTOBUF_PREDICT_FALSE(this_._internal_metadata_.have_unknown_fields())) {
-            target =
-                ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
-                    this_._internal_metadata_.unknown_fields<::google::protobuf::UnknownFieldSet>(::google::protobuf::UnknownFieldSet::default_instance), target, stream);
-          }
-          // @@protoc_insertion_point(serialize_to_array_end:ocr.BatchResult)
-          return target;
-        }
-
-#if defined(PROTOBUF_CUSTOM_VTABLE)
-        ::size_t BatchResult::ByteSizeLong(const MessageLite& base) {
-          const BatchResult& this_ = static_cast<const BatchResult&>(base);
-#else   // PROTOBUF_CUSTOM_VTABLE
-        ::size_t BatchResult::ByteSizeLong() const {
-          const BatchResult& this_ = *this;
-#endif  // PROTOBUF_CUSTOM_VTABLE
-          // @@protoc_insertion_point(message_byte_size_start:ocr.BatchResult)
-          ::size_t total_size = 0;
-
-          ::uint32_t cached_has_bits = 0;
-          // Prevent compiler warnings about cached_has_bits being unused
-          (void)cached_has_bits;
-
-          ::_pbi::Prefetch5LinesFrom7Lines(&this_);
-           {
-            // string text = 2;
-            if (!this_._internal_text().empty()) {
-              total_size += 1 + ::google::protobuf::internal::WireFormatLite::StringSize(
-                                              this_._internal_text());
-            }
-            // int64 processing_time_ms = 3;
-            if (this_._internal_processing_time_ms() != 0) {
-              total_size += ::_pbi::WireFormatLite::Int64SizePlusOne(
-                  this_._internal_processing_time_ms());
-            }
-            // int32 id = 1;
-            if (this_._internal_id() != 0) {
-              total_size += ::_pbi::WireFormatLite::Int32SizePlusOne(
-                  this_._internal_id());
-            }
-          }
-          return this_.MaybeComputeUnknownFieldsSize(total_size,
-                                                     &this_._impl_._cached_size_);
-        }
-
-void BatchResult::MergeImpl(::google::protobuf::MessageLite& to_msg, const ::google::protobuf::MessageLite& from_msg) {
-  auto* const _this = static_cast<BatchResult*>(&to_msg);
-  auto& from = static_cast<const BatchResult&>(from_msg);
-  // @@protoc_insertion_point(class_specific_merge_from_start:ocr.BatchResult)
-  ABSL_DCHECK_NE(&from, _this);
-  ::uint32_t cached_has_bits = 0;
-  (void) cached_has_bits;
-
-  if (!from._internal_text().empty()) {
-    _this->_internal_set_text(from._internal_text());
-  }
-  if (from._internal_processing_time_ms() != 0) {
-    _this->_impl_.processing_time_ms_ = from._impl_.processing_time_ms_;
-  }
-  if (from._internal_id() != 0) {
-    _this->_impl_.id_ = from._impl_.id_;
-  }
-  _this->_internal_metadata_.MergeFrom<::google::protobuf::UnknownFieldSet>(from._internal_metadata_);
-}
-
-void BatchResult::CopyFrom(const BatchResult& from) {
-// @@protoc_insertion_point(class_specific_copy_from_start:ocr.BatchResult)
-  if (&from == this) return;
-  Clear();
-  MergeFrom(from);
-}
-
-
-void BatchResult::InternalSwap(BatchResult* PROTOBUF_RESTRICT other) {
-  using std::swap;
-  auto* arena = GetArena();
-  ABSL_DCHECK_EQ(arena, other->GetArena());
-  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
-  ::_pbi::ArenaStringPtr::InternalSwap(&_impl_.text_, &other->_impl_.text_, arena);
-  ::google::protobuf::internal::memswap<
-      PROTOBUF_FIELD_OFFSET(BatchResult, _impl_.id_)
-      + sizeof(BatchResult::_impl_.id_)
-      - PROTOBUF_FIELD_OFFSET(BatchResult, _impl_.processing_time_ms_)>(
-          reinterpret_cast<char*>(&_impl_.processing_time_ms_),
-          reinterpret_cast<char*>(&other->_impl_.processing_time_ms_));
-}
-
-::google::protobuf::Metadata BatchResult::GetMetadata() const {
-  return ::google::protobuf::Message::GetMetadataImpl(GetClassData()->full());
-}
-// ===================================================================
-
-class BatchResponse::_Internal {
- public:
-};
-
-BatchResponse::BatchResponse(::google::protobuf::Arena* arena)
-#if defined(PROTOBUF_CUSTOM_VTABLE)
-    : ::google::protobuf::Message(arena, _class_data_.base()) {
-#else   // PROTOBUF_CUSTOM_VTABLE
-    : ::google::protobuf::Message(arena) {
-#endif  // PROTOBUF_CUSTOM_VTABLE
-  SharedCtor(arena);
-  // @@protoc_insertion_point(arena_constructor:ocr.BatchResponse)
-}
-inline PROTOBUF_NDEBUG_INLINE BatchResponse::Impl_::Impl_(
-    ::google::protobuf::internal::InternalVisibility visibility, ::google::protobuf::Arena* arena,
-    const Impl_& from, const ::ocr::BatchResponse& from_msg)
-      : results_{visibility, arena, from.results_},
-        _cached_size_{0} {}
-
-BatchResponse::BatchResponse(
-    ::google::protobuf::Arena* arena,
-    const BatchResponse& from)
-#if defined(PROTOBUF_CUSTOM_VTABLE)
-    : ::google::protobuf::Message(arena, _class_data_.base()) {
-#else   // PROTOBUF_CUSTOM_VTABLE
-    : ::google::protobuf::Message(arena) {
-#endif  // PROTOBUF_CUSTOM_VTABLE
-  BatchResponse* const _this = this;
-  (void)_this;
-  _internal_metadata_.MergeFrom<::google::protobuf::UnknownFieldSet>(
-      from._internal_metadata_);
-  new (&_impl_) Impl_(internal_visibility(), arena, from._impl_, from);
-
-  // @@protoc_insertion_point(copy_constructor:ocr.BatchResponse)
-}
-inline PROTOBUF_NDEBUG_INLINE BatchResponse::Impl_::Impl_(
-    ::google::protobuf::internal::InternalVisibility visibility,
-    ::google::protobuf::Arena* arena)
-      : results_{visibility, arena},
-        _cached_size_{0} {}
-
-inline void BatchResponse::SharedCtor(::_pb::Arena* arena) {
-  new (&_impl_) Impl_(internal_visibility(), arena);
-}
-BatchResponse::~BatchResponse() {
-  // @@protoc_insertion_point(destructor:ocr.BatchResponse)
-  SharedDtor(*this);
-}
-inline void BatchResponse::SharedDtor(MessageLite& self) {
-  BatchResponse& this_ = static_cast<BatchResponse&>(self);
-  this_._internal_metadata_.Delete<::google::protobuf::UnknownFieldSet>();
-  ABSL_DCHECK(this_.GetArena() == nullptr);
-  this_._impl_.~Impl_();
-}
-
-inline void* BatchResponse::PlacementNew_(const void*, void* mem,
-                                        ::google::protobuf::Arena* arena) {
-  return ::new (mem) BatchResponse(arena);
-}
-constexpr auto BatchResponse::InternalNewImpl_() {
-  constexpr auto arena_bits = ::google::protobuf::internal::EncodePlacementArenaOffsets({
-      PROTOBUF_FIELD_OFFSET(BatchResponse, _impl_.results_) +
-          decltype(BatchResponse::_impl_.results_)::
-              InternalGetArenaOffset(
-                  ::google::protobuf::Message::internal_visibility()),
-  });
-  if (arena_bits.has_value()) {
-    return ::google::protobuf::internal::MessageCreator::ZeroInit(
-        sizeof(BatchResponse), alignof(BatchResponse), *arena_bits);
-  } else {
-    return ::google::protobuf::internal::MessageCreator(&BatchResponse::PlacementNew_,
-                                 sizeof(BatchResponse),
-                                 alignof(BatchResponse));
-  }
-}
-PROTOBUF_CONSTINIT
-PROTOBUF_ATTRIBUTE_INIT_PRIORITY1
-const ::google::protobuf::internal::ClassDataFull BatchResponse::_class_data_ = {
-    ::google::protobuf::internal::ClassData{
-        &_BatchResponse_default_instance_._instance,
-        &_table_.header,
-        nullptr,  // OnDemandRegisterArenaDtor
-        nullptr,  // IsInitialized
-        &BatchResponse::MergeImpl,
-        ::google::protobuf::Message::GetNewImpl<BatchResponse>(),
-#if defined(PROTOBUF_CUSTOM_VTABLE)
-        &BatchResponse::SharedDtor,
-        ::google::protobuf::Message::GetClearImpl<BatchResponse>(), &BatchResponse::ByteSizeLong,
-            &BatchResponse::_InternalSerialize,
-#endif  // PROTOBUF_CUSTOM_VTABLE
-        PROTOBUF_FIELD_OFFSET(BatchResponse, _impl_._cached_size_),
-        false,
-    },
-    &BatchResponse::kDescriptorMethods,
-    &descriptor_table_ocr_5fservice_2eproto,
-    nullptr,  // tracker
-};
-const ::google::protobuf::internal::ClassData* BatchResponse::GetClassData() const {
-  ::google::protobuf::internal::PrefetchToLocalCache(&_class_data_);
-  ::google::protobuf::internal::PrefetchToLocalCache(_class_data_.tc_table);
-  return _class_data_.base();
-}
-PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1
-const ::_pbi::TcParseTable<0, 1, 1, 0, 2> BatchResponse::_table_ = {
-  {
-    0,  // no _has_bits_
-    0, // no _extensions_
-    1, 0,  // max_field_number, fast_idx_mask
-    offsetof(decltype(_table_), field_lookup_table),
-    4294967294,  // skipmap
-    offsetof(decltype(_table_), field_entries),
-    1,  // num_field_entries
-    1,  // num_aux_entries
-    offsetof(decltype(_table_), aux_entries),
-    _class_data_.base(),
-    nullptr,  // post_loop_handler
-    ::_pbi::TcParser::GenericFallback,  // fallback
-    #ifdef PROTOBUF_PREFETCH_PARSE_TABLE
-    ::_pbi::TcParser::GetTable<::ocr::BatchResponse>(),  // to_prefetch
-    #endif  // PROTOBUF_PREFETCH_PARSE_TABLE
-  }, {{
-    // repeated .ocr.BatchResult results = 1;
-    {::_pbi::TcParser::FastMtR1,
-     {10, 63, 0, PROTOBUF_FIELD_OFFSET(BatchResponse, _impl_.results_)}},
-  }}, {{
-    65535, 65535
-  }}, {{
-    // repeated .ocr.BatchResult results = 1;
-    {PROTOBUF_FIELD_OFFSET(BatchResponse, _impl_.results_), 0, 0,
-    (0 | ::_fl::kFcRepeated | ::_fl::kMessage | ::_fl::kTvTable)},
-  }}, {{
-    {::_pbi::TcParser::GetTable<::ocr::BatchResult>()},
-  }}, {{
-  }},
-};
-
-PROTOBUF_NOINLINE void BatchResponse::Clear() {
-// @@protoc_insertion_point(message_clear_start:ocr.BatchResponse)
-  ::google::protobuf::internal::TSanWrite(&_impl_);
-  ::uint32_t cached_has_bits = 0;
-  // Prevent compiler warnings about cached_has_bits being unused
-  (void) cached_has_bits;
-
-  _impl_.results_.Clear();
-  _internal_metadata_.Clear<::google::protobuf::UnknownFieldSet>();
-}
-
-#if defined(PROTOBUF_CUSTOM_VTABLE)
-        ::uint8_t* BatchResponse::_InternalSerialize(
-            const MessageLite& base, ::uint8_t* target,
-            ::google::protobuf::io::EpsCopyOutputStream* stream) {
-          const BatchResponse& this_ = static_cast<const BatchResponse&>(base);
-#else   // PROTOBUF_CUSTOM_VTABLE
-        ::uint8_t* BatchResponse::_InternalSerialize(
-            ::uint8_t* target,
-            ::google::protobuf::io::EpsCopyOutputStream* stream) const {
-          const BatchResponse& this_ = *this;
-#endif  // PROTOBUF_CUSTOM_VTABLE
-          // @@protoc_insertion_point(serialize_to_array_start:ocr.BatchResponse)
-          ::uint32_t cached_has_bits = 0;
-          (void)cached_has_bits;
-
-          // repeated .ocr.BatchResult results = 1;
-          for (unsigned i = 0, n = static_cast<unsigned>(
-                                   this_._internal_results_size());
-               i < n; i++) {
-            const auto& repfield = this_._internal_results().Get(i);
-            target =
-                ::google::protobuf::internal::WireFormatLite::InternalWriteMessage(
-                    1, repfield, repfield.GetCachedSize(),
-                    target, stream);
-          }
-
-          if (PROTOBUF_PREDICT_FALSE(this_._internal_metadata_.have_unknown_fields())) {
-            target =
-                ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
-                    this_._internal_metadata_.unknown_fields<::google::protobuf::UnknownFieldSet>(::google::protobuf::UnknownFieldSet::default_instance), target, stream);
-          }
-          // @@protoc_insertion_point(serialize_to_array_end:ocr.BatchResponse)
-          return target;
-        }
-
-#if defined(PROTOBUF_CUSTOM_VTABLE)
-        ::size_t BatchResponse::ByteSizeLong(const MessageLite& base) {
-          const BatchResponse& this_ = static_cast<const BatchResponse&>(base);
-#else   // PROTOBUF_CUSTOM_VTABLE
-        ::size_t BatchResponse::ByteSizeLong() const {
-          const BatchResponse& this_ = *this;
-#endif  // PROTOBUF_CUSTOM_VTABLE
-          // @@protoc_insertion_point(message_byte_size_start:ocr.BatchResponse)
-          ::size_t total_size = 0;
-
-          ::uint32_t cached_has_bits = 0;
-          // Prevent compiler warnings about cached_has_bits being unused
-          (void)cached_has_bits;
-
-          ::_pbi::Prefetch5LinesFrom7Lines(&this_);
-           {
-            // repeated .ocr.BatchResult results = 1;
-            {
-              total_size += 1UL * this_._internal_results_size();
-              for (const auto& msg : this_._internal_results()) {
-                total_size += ::google::protobuf::internal::WireFormatLite::MessageSize(msg);
-              }
-            }
-          }
-          return this_.MaybeComputeUnknownFieldsSize(total_size,
-                                                     &this_._impl_._cached_size_);
-        }
-
-void BatchResponse::MergeImpl(::google::protobuf::MessageLite& to_msg, const ::google::protobuf::MessageLite& from_msg) {
-  auto* const _this = static_cast<BatchResponse*>(&to_msg);
-  auto& from = static_cast<const BatchResponse&>(from_msg);
-  // @@protoc_insertion_point(class_specific_merge_from_start:ocr.BatchResponse)
-  ABSL_DCHECK_NE(&from, _this);
-  ::uint32_t cached_has_bits = 0;
-  (void) cached_has_bits;
-
-  _this->_internal_mutable_results()->MergeFrom(
-      from._internal_results());
-  _this->_internal_metadata_.MergeFrom<::google::protobuf::UnknownFieldSet>(from._internal_metadata_);
-}
-
-void BatchResponse::CopyFrom(const BatchResponse& from) {
-// @@protoc_insertion_point(class_specific_copy_from_start:ocr.BatchResponse)
-  if (&from == this) return;
-  Clear();
-  MergeFrom(from);
-}
-
-
-void BatchResponse::InternalSwap(BatchResponse* PROTOBUF_RESTRICT other) {
-  using std::swap;
-  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
-  _impl_.results_.InternalSwap(&other->_impl_.results_);
-}
-
-::google::protobuf::Metadata BatchResponse::GetMetadata() const {
-  return ::google::protobuf::Message::GetMetadataImpl(GetClassData()->full());
-}
-// @@protoc_insertion_point(namespace_scope)
-}  // namespace ocr
-namespace google {
-namespace protobuf {
-}  // namespace protobuf
-}  // namespace google
-// @@protoc_insertion_point(global_scope)
-PROTOBUF_ATTRIBUTE_INIT_PRIORITY2 static ::std::false_type
-    _static_init2_ PROTOBUF_UNUSED =
-        (::_pbi::AddDescriptors(&descriptor_table_ocr_5fservice_2eproto),
-         ::std::false_type{});
-#include "google/protobuf/port_undef.inc"